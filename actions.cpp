@@ -261,14 +261,7 @@ void PelrockEngine::addInventoryItem(int item) {
 	int frameCounter = 0;
 	_state->addInventoryItem(item);
 	while (frameCounter < kIconFlashDuration) {
-		_events->pollEvent();
-
-		bool didRender = renderScene(OVERLAY_PICKUP_ICON);
-		_screen->update();
-		if (didRender) {
-			frameCounter++;
-		}
-		g_system->delayMillis(10);
+		frameCounter += pumpFrame(OVERLAY_PICKUP_ICON);
 	}
 
 	checkObjectsForPart2();
@@ -597,7 +590,7 @@ void PelrockEngine::dialogActionTrigger(uint16 actionTrigger, byte room, byte ro
 				break;
 			}
 			_screen->update();
-			g_system->delayMillis(10);
+			_chrono->waitForNextTick();
 		}
 		_room->disableSprite(0);
 		_state->setCurrentRoot(room, 2, 0);
@@ -699,6 +692,7 @@ void PelrockEngine::dialogActionTrigger(uint16 actionTrigger, byte room, byte ro
  */
 void PelrockEngine::turnLightsOff() {
 	_currentBackground.clear(0);
+	_backgroundModified = true;
 	_compositeBuffer.clear(0);
 	_screen->clear(0);
 	byte darkPalette[768] = {};
@@ -915,50 +909,7 @@ void PelrockEngine::openLamppost(HotSpot *hotspot) {
 }
 
 void PelrockEngine::useBrickWithWindow(int inventoryObject, HotSpot *hotspot) {
-
-	playAlfredSpecialAnim(4);
-
-	Sprite *brickSprite = _room->findSpriteByIndex(7);
-	HotSpot *windowHotspot = _room->findHotspotByExtra(294);
-	brickSprite->x = 420;
-	brickSprite->y = 241;
-	brickSprite->zOrder = 10;
-	while (!shouldQuit()) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_room->findSpriteByIndex(7)->y -= 10;
-		if (_room->findSpriteByIndex(7)->y <= 70) {
-			_room->findSpriteByIndex(7)->zOrder = 255;
-			break;
-		}
-		_screen->update();
-		g_system->delayMillis(10);
-	}
-
-	debug("Brick hit the window");
-	_room->addSticker(11);
-	_sound->playSound(_room->_roomSfx[2]); // Play glass breaking sound
-
-	// Remove brick from inventory
-	_state->removeInventoryItem(4);
-
-	int16 x = 639; // put at the very edge of the screen so it gets adjusted
-	int16 y = windowHotspot->y;
-	// Play the NPC dialog sequence
-	int16 dialog1y = y + 22;
-	int16 dialog2y = dialog1y + 10 + _largeFont->getFontHeight();
-	_dialog->say(_res->_ingameTexts[kTextQueHaSidoEso], x, dialog1y);
-	_dialog->say(_res->_ingameTexts[kTextQuienAndaAhi], x, dialog2y);
-	_dialog->say(_res->_ingameTexts[kTextYoMeVoy]);
-	_state->setFlag(FLAG_STONE_THROWN, true);
-	_state->setFlag(FLAG_OPEN_SHOP, true);
-	_room->addStickerToRoom(_room->_currentRoomNumber, 9, PERSIST_PERM);
-	_room->addStickerToRoom(_room->_currentRoomNumber, 10, PERSIST_PERM);
-	_room->disableHotspot(_room->findHotspotByExtra(295));
-	_room->disableHotspot(_room->findHotspotByExtra(294)); // Disable window hotspot
-	_room->enableSprite(5, 100, PERSIST_PERM);             // Enable fake teeth sprite
-	_disableAction = true;                                 // Prevent player from doing anything until the action is done
-	walkTo(630, _alfredState.y);
+	startSequence(kSequenceBrickWindow);
 }
 
 void PelrockEngine::moveCable(HotSpot *hotspot) {
@@ -1234,6 +1185,7 @@ void PelrockEngine::usePumpkinWithRiver(int inventoryObject, HotSpot *hotspot) {
 			static const int copyW = 127, copyH = 80;
 			Common::Rect copyRect(srcX, srcY, srcX + copyW, srcY + copyH);
 			_currentBackground.blitFrom(_compositeBuffer, copyRect, Common::Point(srcX, srcY));
+			_backgroundModified = true;
 		}
 		_alfredState.animState = ALFRED_SKIP_DRAWING;
 		_sound->playSound(_room->_roomSfx[0], 0); // Belch
@@ -1249,17 +1201,18 @@ void PelrockEngine::usePumpkinWithRiver(int inventoryObject, HotSpot *hotspot) {
 }
 
 void PelrockEngine::playAlfredSpecialAnim(int anim, bool reverse) {
+	startAlfredSpecialAnim(anim, reverse);
+	waitForSpecialAnimation();
+}
+
+void PelrockEngine::startAlfredSpecialAnim(int anim, bool reverse) {
 	_res->loadAlfredSpecialAnim(anim, reverse);
 	_alfredState.animState = ALFRED_SPECIAL_ANIM;
-	waitForSpecialAnimation();
 }
 
 void PelrockEngine::waitForSoundEnd(int channel) {
 	while (!shouldQuit() && _sound->isPlaying(channel)) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_screen->update();
-		g_system->delayMillis(10);
+		pumpFrame();
 	}
 }
 
@@ -1508,7 +1461,7 @@ void PelrockEngine::guardMovement() {
 			break;
 		}
 		_screen->update();
-		g_system->delayMillis(10);
+		_chrono->waitForNextTick();
 	}
 }
 
@@ -1536,26 +1489,27 @@ void PelrockEngine::playSpecialAnim(uint32 offset, bool compressed, int x, int y
 	Graphics::Surface animSurface;
 	animSurface.create(width, height, Graphics::PixelFormat::createFormatCLUT8());
 	int curFrame = 0;
+	int animTicks = 0;
 	while (!shouldQuit()) {
 		_events->pollEvent();
 
-		bool didRender = renderScene(OVERLAY_NONE);
-		if (didRender) {
+		int ticks = renderScene(OVERLAY_NONE);
+		if (ticks) {
 			memset(animSurface.getPixels(), 0, frameSize);
 			extractSingleFrame(animData, (byte *)animSurface.getPixels(), curFrame, width, height);
 			_screen->transBlitFrom(animSurface, Common::Point(x, y), 255);
-			if (_chrono->getFrameCount() % 2 == 0) {
-				curFrame++;
-				if (curFrame >= numFrames) {
-					_screen->markAllDirty();
-					_screen->update();
-					break;
-				}
+			// One animation frame every other tick
+			animTicks += ticks;
+			curFrame = animTicks / 2;
+			if (curFrame >= numFrames) {
+				_screen->markAllDirty();
+				_screen->update();
+				break;
 			}
 		}
 		_screen->markAllDirty();
 		_screen->update();
-		g_system->delayMillis(10);
+		_chrono->waitForNextTick();
 	}
 	animSurface.free();
 	delete[] animData;
@@ -1568,7 +1522,7 @@ void PelrockEngine::giveStoneToSlaves(int inventoryObject, HotSpot *hotspot) {
 	Sprite *masters = _room->findSpriteByExtra(600);
 	byte zIndex = masters->zOrder;
 	// Capture coordinates now, before any playSpecialAnim loop runs renderScene and
-	// sortAnimsByZOrder reorders _currentRoomAnims (which would make the pointer stale).
+	// the sprite starts moving.
 	int16 mastersX = masters->x;
 	int16 mastersY = masters->y;
 
@@ -1617,103 +1571,7 @@ void PelrockEngine::giveStoneToSlaves(int inventoryObject, HotSpot *hotspot) {
  * "diving" animation is stored in Alfred.7 as a single RLE chunk with multiple continuous sprite sizes.
  */
 void PelrockEngine::swimmingPoolCutscene(HotSpot *hotspot) {
-	byte *buffer = nullptr;
-	size_t bufSize = 0;
-
-	struct SwimmerInfo {
-		int spriteIndex;
-		int16 x;
-		int16 y;
-		int w;
-		int h;
-		int nFrames;
-		int totalSize;
-		uint16 movementFlags;
-	};
-
-	SwimmerInfo swimmers[4] = {
-		{3, 3, -17, 93, 88, 9, 93 * 88 * 9, 0x02FF}, // Move right and up
-		{4, 1, 0, 68, 31, 7, 68 * 31 * 7, 0},
-		{5, -14, -18, 79, 95, 9, 79 * 95 * 9, 0},
-		{6, -1, -8, 54, 42, 8, 54 * 42 * 8, 0}};
-
-	_res->loadOtherSpecialAnim(1446862, true, buffer, bufSize);
-
-	int acc = 0;
-	for (int i = 0; i < 4; i++) {
-		Sprite *sprite = _room->findSpriteByIndex(swimmers[i].spriteIndex);
-		sprite->x = sprite->x + swimmers[i].x;
-		sprite->y = sprite->y + swimmers[i].y;
-		sprite->w = swimmers[i].w;
-		sprite->h = swimmers[i].h;
-		sprite->animData[0].nframes = swimmers[i].nFrames;
-		sprite->animData[0].movementFlags = swimmers[i].movementFlags;
-		sprite->animData[0].curFrame = 0;
-		sprite->animData[0].loopCount = 0;
-		sprite->animData[0].curLoop = 0;
-		sprite->animData[0].speed = 0;
-		sprite->animData[0].elpapsedFrames = 0;
-		sprite->disableAfterSequence = true;
-
-		sprite->animData[0].animData = new byte *[sprite->animData[0].nframes];
-		for (int j = 0; j < sprite->animData[0].nframes; j++) {
-			sprite->animData[0].animData[j] = new byte[sprite->w * sprite->h];
-			extractSingleFrame(buffer + acc, sprite->animData[0].animData[j], j, sprite->w, sprite->h);
-		}
-		acc += sprite->w * sprite->h * sprite->animData[0].nframes;
-	}
-
-	_sound->stopMusic();
-	_sound->playMusicTrack(28);
-	while (!shouldQuit()) {
-		_events->pollEvent();
-		bool didRender = renderScene(OVERLAY_NONE);
-
-		if (didRender) {
-			if (_room->findSpriteByIndex(swimmers[0].spriteIndex)->zOrder == 255) {
-				break;
-			}
-		}
-		_screen->update();
-		g_system->delayMillis(10);
-	}
-	_state->setFlag(FLAG_EUNUCH_APPEARS, true);
-	Sprite *guard = _room->findSpriteByIndex(0);
-	guard->animData[0].movementFlags = 0x14;
-	while (!shouldQuit()) {
-		_events->pollEvent();
-		renderScene();
-		if (guard->x <= _alfredState.x + 70) {
-			break;
-		}
-		_screen->update();
-		g_system->delayMillis(10);
-	}
-
-	guard->animData[0].movementFlags = 0;
-	guard->animData[0].curFrame = 0;
-	guard->animData[0].nframes = 1;
-	// copy idle frame from talking animation
-	guard->animData[0].animData[0] = _room->_talkingAnims.animA[0];
-	_alfredState.direction = ALFRED_RIGHT;
-	walkAndAction(_room->findHotspotByExtra(guard->extra), TALK);
-	if (shouldQuit()) {
-		return;
-	}
-	_graphics->fadeToBlack(10);
-	_alfredState.x = 271;
-	_alfredState.y = 385;
-	setScreenAndPrepare(40, ALFRED_UP);
-	_state->setFlag(FLAG_PHARAOH_VIEWING, true);
-	walkAndAction(_room->findHotspotByExtra(640), TALK);
-	if (shouldQuit()) {
-		return;
-	}
-	_graphics->fadeToBlack(10);
-	_alfredState.x = 271;
-	_alfredState.y = 385;
-	_state->setFlag(FLAG_TO_WORK, true);
-	setScreenAndPrepare(41, ALFRED_UP);
+	startSequence(kSequenceSwimmingPool);
 }
 
 void PelrockEngine::pickUpStones(HotSpot *hotspot) {
@@ -1799,51 +1657,67 @@ void PelrockEngine::magicFormula(int inventoryObject, HotSpot *hotspot) {
 	}
 }
 
+static const int kSmokeWidth = 98;
+static const int kSmokeHeight = 138;
+static const int kSmokeFrames = 11;
+static const int kSmokeSwapFrame = 5; // the sprite or Alfred appears or vanishes behind this frame
+
 void PelrockEngine::smokeAnimation(int spriteIndex, bool hide) {
-	size_t frameSize = 98 * 138;
-	size_t bufSize = frameSize * 11;
-	byte *smokeFrames = new byte[bufSize];
-	_res->loadOtherSpecialAnim(1526432, true, smokeFrames, bufSize);
-	Graphics::Surface smokeSurface;
-	smokeSurface.create(98, 138, Graphics::PixelFormat::createFormatCLUT8());
-	int curFrame = 0;
-	int x = _alfredState.x;
-	int y = _alfredState.y - _alfredState.h;
-	if (spriteIndex >= 0) {
-		x = _room->findSpriteByIndex(spriteIndex)->x;
-		y = _room->findSpriteByIndex(spriteIndex)->y;
+	startSmokeAnimation(spriteIndex, hide);
+	while (!shouldQuit() && _smokeState.isActive) {
+		pumpFrame();
 	}
-	while (!shouldQuit()) {
-		_events->pollEvent();
+}
 
-		bool didRender = renderScene(OVERLAY_NONE);
-
-		memset(smokeSurface.getPixels(), 0, frameSize);
-		extractSingleFrame(smokeFrames, (byte *)smokeSurface.getPixels(), curFrame, 98, 138);
-		_screen->transBlitFrom(smokeSurface, Common::Point(x, y), 255);
-		if (curFrame == 5) {
-			if (spriteIndex == -1) {
-				_alfredState.setState(ALFRED_SKIP_DRAWING);
-			} else {
-				if (hide) {
-					_room->disableSprite(spriteIndex);
-				} else {
-					_room->enableSprite(spriteIndex, 200);
-				}
-			}
-		}
-		if (didRender && _chrono->getFrameCount()) {
-			curFrame++;
+void PelrockEngine::startSmokeAnimation(int spriteIndex, bool hide) {
+	stopSmokeAnimation();
+	// The decompressor allocates the frames with malloc
+	size_t bufSize = 0;
+	_res->loadOtherSpecialAnim(1526432, true, _smokeState.frames, bufSize);
+	_smokeState.x = _alfredState.x;
+	_smokeState.y = _alfredState.y - _alfredState.h;
+	if (spriteIndex >= 0) {
+		_smokeState.x = _room->findSpriteByIndex(spriteIndex)->x;
+		_smokeState.y = _room->findSpriteByIndex(spriteIndex)->y;
+	}
+	_smokeState.spriteIndex = spriteIndex;
+	_smokeState.hide = hide;
+	_smokeState.curFrame = 0;
+	_smokeState.swapped = false;
+	_smokeState.isActive = true;
+}
 
-			if (curFrame >= 11) {
-				break;
-			}
+void PelrockEngine::updateSmokeAnimation(int ticks) {
+	if (!_smokeState.isActive)
+		return;
+	Graphics::Surface smokeSurface;
+	smokeSurface.init(kSmokeWidth, kSmokeHeight, kSmokeWidth, _smokeState.frames + _smokeState.curFrame * kSmokeWidth * kSmokeHeight,
+					  Graphics::PixelFormat::createFormatCLUT8());
+	_screen->transBlitFrom(smokeSurface, Common::Point(_smokeState.x, _smokeState.y), 255);
+	// Catch-up ticks can skip the swap frame itself
+	if (_smokeState.curFrame >= kSmokeSwapFrame && !_smokeState.swapped) {
+		_smokeState.swapped = true;
+		if (_smokeState.spriteIndex == -1) {
+			_alfredState.setState(ALFRED_SKIP_DRAWING);
+		} else if (_smokeState.hide) {
+			_room->disableSprite(_smokeState.spriteIndex);
+		} else {
+			_room->enableSprite(_smokeState.spriteIndex, 200);
 		}
-		_screen->update();
-		g_system->delayMillis(10);
+	}
+	if (_chrono->getFrameCount()) {
+		_smokeState.curFrame += ticks;
+		if (_smokeState.curFrame >= kSmokeFrames)
+			stopSmokeAnimation();
 	}
 }
 
+void PelrockEngine::stopSmokeAnimation() {
+	free(_smokeState.frames);
+	_smokeState.frames = nullptr;
+	_smokeState.isActive = false;
+}
+
 void PelrockEngine::openArchitectDoor(HotSpot *hotspot) {
 	openDoor(hotspot, 2, 124, FEMININE, true);
 }
@@ -1976,9 +1850,7 @@ void PelrockEngine::teleportToPrincess() {
 		thisSprite->zOrder = 200;
 
 		while (!shouldQuit() && _room->findSpriteByIndex(phase + 1)->zOrder != 255) {
-			_events->pollEvent();
-			renderScene(OVERLAY_NONE);
-			_screen->update();
+			pumpFrame();
 		}
 
 		_sound->playSound(_room->_roomSfx[3], 0);
@@ -2018,16 +1890,7 @@ void PelrockEngine::teleportToPrincess() {
 		phase++;
 	}
 	// small delay before last sticker
-	int delay = 10;
-	while (!shouldQuit() && delay > 0) {
-		_events->pollEvent();
-		bool didRender = renderScene(OVERLAY_NONE);
-		_screen->update();
-		g_system->delayMillis(10);
-		if (didRender) {
-			delay--;
-		}
-	}
+	waitTicks(10);
 
 	_room->addSticker(115);
 	_graphics->copyBackgroundToBuffer();
@@ -2126,7 +1989,7 @@ void PelrockEngine::useOnAlfred(int inventoryObject) {
 						}
 						_screen->markAllDirty();
 						_screen->update();
-						g_system->delayMillis(10);
+						_chrono->waitForNextTick();
 					}
 
 					_alfredState.x = 145;
@@ -2143,7 +2006,7 @@ void PelrockEngine::useOnAlfred(int inventoryObject) {
 				_sound->playSound(_room->_roomSfx[8], 0);
 				_dialog->say(_res->_ingameTexts[kTextDiosHalcon + spell->page], 1);
 				int flightIndex = _room->_currentRoomNumber - 51;
-				if (_fightSorcererAppeared && !_fightInBlockingAnim && spell->page == kFightRooms[flightIndex].spellPage) {
+				if (_fightSorcererAppeared && !isSequenceRunning(kSequenceSorcererSpell) && spell->page == kFightRooms[flightIndex].spellPage) {
 					_state->setFlag(FLAG_GODS_STANCES, _state->getFlag(FLAG_GODS_STANCES) | (1 << flightIndex));
 					_sound->playSound(_room->_roomSfx[1], 0);
 					smokeAnimation(kFightRooms[flightIndex].spriteIdx, true);
@@ -2327,8 +2190,8 @@ void PelrockEngine::animateStatuePaletteFade(bool reverse) {
 	while (!shouldQuit() && frame <= numFrames) {
 		_events->pollEvent();
 
-		bool didRender = renderScene(OVERLAY_NONE);
-		if (didRender) {
+		int ticks = renderScene(OVERLAY_NONE);
+		if (ticks) {
 
 			for (int i = 0; i < 16; i++) {
 				byte paletteIndex = paletteData.indices[i];
@@ -2347,10 +2210,11 @@ void PelrockEngine::animateStatuePaletteFade(bool reverse) {
 			}
 
 			g_system->getPaletteManager()->setPalette(currentPalette, 0, 256);
-			frame++;
+			// Skipped steps still land on the target palette before the loop ends
+			frame = frame < numFrames ? MIN(frame + ticks, numFrames) : numFrames + 1;
 		}
 		_screen->update();
-		g_system->delayMillis(10);
+		_chrono->waitForNextTick();
 	}
 }
 
@@ -2374,9 +2238,7 @@ void PelrockEngine::checkObjectsForPart2() {
 
 void PelrockEngine::waitForActionEnd() {
 	while (!shouldQuit() && _queuedAction.isQueued) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_screen->update();
+		pumpFrame();
 	}
 }
 
@@ -2452,7 +2314,7 @@ void PelrockEngine::antiPiracyEffect() {
 
 		_screen->markAllDirty();
 		_screen->update();
-		g_system->delayMillis(10);
+		_chrono->idle();
 	}
 }
 
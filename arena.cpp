@@ -0,0 +1,74 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/debug.h"
+#include "common/textconsole.h"
+
+#include "pelrock/arena.h"
+#include "pelrock/pelrock.h"
+
+namespace Pelrock {
+
+FrameArena::~FrameArena() {
+	reset();
+	delete[] _block;
+	g_engine->_memStats.remove(_tag, _capacity);
+}
+
+void FrameArena::reserve(uint32 size) {
+	if (_used != 0) {
+		warning("FrameArena: reserve() while %u bytes are in use", _used);
+		return;
+	}
+	if (size <= _capacity)
+		return;
+	delete[] _block;
+	g_engine->_memStats.remove(_tag, _capacity);
+	_block = new byte[size];
+	_capacity = size;
+	g_engine->_memStats.add(_tag, _capacity);
+}
+
+byte *FrameArena::alloc(uint32 size) {
+	size = alignedSize(size);
+	if (_used + size <= _capacity) {
+		byte *ptr = _block + _used;
+		_used += size;
+		return ptr;
+	}
+	debug(3, "FrameArena: %u bytes do not fit (%u/%u used), using the heap", size, _used, _capacity);
+	byte *ptr = new byte[size];
+	_overflow.push_back(ptr);
+	_overflowBytes += size;
+	g_engine->_memStats.add(_tag, size);
+	return ptr;
+}
+
+void FrameArena::reset() {
+	for (uint i = 0; i < _overflow.size(); i++) {
+		delete[] _overflow[i];
+	}
+	_overflow.clear();
+	g_engine->_memStats.remove(_tag, _overflowBytes);
+	_overflowBytes = 0;
+	_used = 0;
+}
+
+} // End of namespace Pelrock
@@ -0,0 +1,66 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_ARENA_H
+#define PELROCK_ARENA_H
+
+#include "common/array.h"
+#include "common/scummsys.h"
+
+#include "pelrock/memstats.h"
+
+namespace Pelrock {
+
+/**
+ * Bump allocator for data that lives exactly as long as a room: sprite frames, their frame
+ * pointer tables and talking animation frames. Everything is released at once by reset(), and
+ * the block is kept for the next room when it is big enough, so room changes stop hitting the heap.
+ * Requests that do not fit fall back to individual heap blocks, which reset() also frees.
+ */
+class FrameArena {
+public:
+	explicit FrameArena(MemTag tag = kMemRoom) : _tag(tag) {}
+	~FrameArena();
+
+	/** Makes sure the block holds at least size bytes. Only valid right after reset(). */
+	void reserve(uint32 size);
+	byte *alloc(uint32 size);
+	byte **allocFrameTable(int count) { return (byte **)alloc(count * sizeof(byte *)); }
+	void reset();
+
+	uint32 getCapacity() const { return _capacity; }
+	uint32 getUsed() const { return _used; }
+	uint32 getOverflowCount() const { return _overflow.size(); }
+
+	/** Size alloc() will actually consume for a request, for sizing passes. */
+	static uint32 alignedSize(uint32 size) { return (size + 7) & ~7u; }
+
+private:
+	MemTag _tag;
+	byte *_block = nullptr;
+	uint32 _capacity = 0;
+	uint32 _used = 0;
+	Common::Array<byte *> _overflow;
+	uint32 _overflowBytes = 0;
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_ARENA_H
@@ -0,0 +1,142 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/algorithm.h"
+
+#include "pelrock/audiocues.h"
+#include "pelrock/pelrock.h"
+
+namespace Pelrock {
+
+AudioCueScheduler::~AudioCueScheduler() {
+	clear();
+}
+
+void AudioCueScheduler::addSampleCue(uint32 frame, int channel, SoundCategory category, bool queued,
+									 Common::SeekableReadStream *source, uint32 offset, uint32 length) {
+	Cue cue;
+	cue.frame = frame;
+	cue.channel = channel;
+	cue.category = category;
+	cue.queued = queued;
+	cue.source = source;
+	cue.offset = offset;
+	cue.length = length;
+	_cues.push_back(cue);
+}
+
+void AudioCueScheduler::addMusicCue(uint32 frame, int track, bool loop) {
+	Cue cue;
+	cue.frame = frame;
+	cue.musicTrack = track;
+	cue.loop = loop;
+	_cues.push_back(cue);
+}
+
+void AudioCueScheduler::start() {
+	Common::sort(_cues.begin(), _cues.end(), [](const Cue &a, const Cue &b) {
+		return a.frame < b.frame;
+	});
+	_nextDue = 0;
+	_nextLoad = 0;
+}
+
+void AudioCueScheduler::update(uint32 frame) {
+	while (_nextLoad < _cues.size() && _cues[_nextLoad].frame <= frame + kCueLookaheadFrames) {
+		load(_cues[_nextLoad]);
+		_nextLoad++;
+	}
+	while (_nextDue < _cues.size() && _cues[_nextDue].frame <= frame) {
+		_waiting.push_back(_cues[_nextDue]);
+		_waiting.back().dueTime = g_system->getMillis();
+		// The copy owns the data now
+		_cues[_nextDue].data = nullptr;
+		_nextDue++;
+	}
+	service();
+}
+
+void AudioCueScheduler::service() {
+	uint32 blockedChannels = 0;
+	for (uint i = 0; i < _waiting.size();) {
+		Cue &cue = _waiting[i];
+		bool isSample = cue.musicTrack == 0;
+		if (isSample && ((blockedChannels & (1 << cue.channel)) || (cue.queued && _sound->isPlaying(cue.channel)))) {
+			// Later cues for the same channel stay behind this one
+			blockedChannels |= 1 << cue.channel;
+			i++;
+			continue;
+		}
+		play(cue);
+		_waiting.remove_at(i);
+	}
+}
+
+void AudioCueScheduler::clear() {
+	for (uint i = 0; i < _cues.size(); i++)
+		releaseData(_cues[i]);
+	for (uint i = 0; i < _waiting.size(); i++)
+		releaseData(_waiting[i]);
+	_cues.clear();
+	_waiting.clear();
+	_nextDue = 0;
+	_nextLoad = 0;
+}
+
+void AudioCueScheduler::load(Cue &cue) {
+	if (cue.musicTrack != 0 || cue.data || cue.length == 0)
+		return;
+	// malloc'd: the raw stream frees it with free()
+	cue.data = (byte *)malloc(cue.length);
+	g_engine->_memStats.add(kMemSound, cue.length);
+	uint32 readStart = g_system->getMillis();
+	cue.source->seek(cue.offset, SEEK_SET);
+	cue.source->read(cue.data, cue.length);
+	_sound->recordRead("scheduled cue", g_system->getMillis() - readStart);
+}
+
+void AudioCueScheduler::play(Cue &cue) {
+	if (cue.musicTrack != 0) {
+		_sound->playMusicTrack(cue.musicTrack, cue.loop);
+		return;
+	}
+	bool readAhead = cue.data != nullptr;
+	load(cue);
+	if (!cue.data)
+		return;
+	// Only queued cues can be held past their frame
+	uint32 delay = g_system->getMillis() - cue.dueTime;
+	if (delay > 0)
+		_sound->recordCueDelay(delay);
+	// playSound hands the buffer to the stream and accounts for it as such
+	g_engine->_memStats.remove(kMemSound, cue.length);
+	_sound->playSound(cue.data, cue.length, cue.channel, cue.category, readAhead);
+	cue.data = nullptr;
+}
+
+void AudioCueScheduler::releaseData(Cue &cue) {
+	if (!cue.data)
+		return;
+	free(cue.data);
+	g_engine->_memStats.remove(kMemSound, cue.length);
+	cue.data = nullptr;
+}
+
+} // End of namespace Pelrock
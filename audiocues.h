@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_AUDIOCUES_H
+#define PELROCK_AUDIOCUES_H
+
+#include "common/array.h"
+#include "common/scummsys.h"
+#include "common/stream.h"
+
+#include "pelrock/sound.h"
+
+namespace Pelrock {
+
+/** How many frames ahead of a cue its sample is read into memory. */
+static const uint32 kCueLookaheadFrames = 8;
+
+/**
+ * Plays audio on a frame timeline without holding up whoever drives the frames.
+ * Samples are read shortly before they are due, so starting one costs nothing on its frame.
+ * Queued cues wait for their channel to be free instead of cutting off what plays there; they keep
+ * their order and start on the first update after the channel clears.
+ */
+class AudioCueScheduler {
+public:
+	explicit AudioCueScheduler(SoundManager *sound) : _sound(sound) {}
+	~AudioCueScheduler();
+
+	/** Raw PCM at offset in source; the source must outlive the cue. */
+	void addSampleCue(uint32 frame, int channel, SoundCategory category, bool queued,
+					  Common::SeekableReadStream *source, uint32 offset, uint32 length);
+	void addMusicCue(uint32 frame, int track, bool loop);
+	/** Orders the timeline; call once every cue is in, before the first update. */
+	void start();
+
+	/** Starts everything due by this frame and reads the samples coming up. */
+	void update(uint32 frame);
+	/** Retries the queued cues that are already due, for use between frames. */
+	void service();
+	/** Whether due cues are still held back behind their channel. */
+	bool hasWaiting() const { return !_waiting.empty(); }
+	void clear();
+
+private:
+	struct Cue {
+		uint32 frame = 0;
+		int channel = 0;
+		SoundCategory category = kSoundScripted;
+		bool queued = false;
+		int musicTrack = 0; // music cues only
+		bool loop = false;
+		Common::SeekableReadStream *source = nullptr;
+		uint32 offset = 0;
+		uint32 length = 0;
+		byte *data = nullptr; // read ahead, handed to the mixer when started
+		uint32 dueTime = 0;   // real time the cue's frame was reached
+	};
+
+	void load(Cue &cue);
+	void play(Cue &cue);
+	void releaseData(Cue &cue);
+
+	SoundManager *_sound;
+	Common::Array<Cue> _cues; // by frame
+	uint _nextDue = 0;
+	uint _nextLoad = 0;
+	Common::Array<Cue> _waiting; // due, in order, waiting on their channel
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_AUDIOCUES_H
@@ -0,0 +1,190 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/debug.h"
+#include "common/savefile.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/timer.h"
+#include "engines/metaengine.h"
+
+#include "pelrock/autosave.h"
+
+namespace Pelrock {
+
+static const int32 kAutosavePollUs = 20 * 1000;
+// Data handed to the compressing save file per timer callback
+static const uint32 kAutosaveChunkSize = 16 * 1024;
+
+AsyncSaveWriter::AsyncSaveWriter() {
+	_timerInstalled = g_system->getTimerManager()->installTimerProc(&timerProc, kAutosavePollUs, this, "pelrockAutosave");
+	if (!_timerInstalled)
+		warning("AsyncSaveWriter: no timer available, autosaves will be written synchronously");
+}
+
+AsyncSaveWriter::~AsyncSaveWriter() {
+	if (_timerInstalled)
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+	flush();
+}
+
+bool AsyncSaveWriter::submit(int slot, const Common::String &fileName, const Common::String &desc, uint32 playTime,
+							 Common::MemoryWriteStreamDynamic *data, Graphics::Surface *thumb) {
+	Job *job = new Job();
+	job->slot = slot;
+	job->fileName = fileName;
+	job->desc = desc;
+	job->playTime = playTime;
+	job->data = data;
+	job->thumb = thumb;
+	{
+		Common::StackLock lock(_mutex);
+		if (_pending == nullptr && _writing == nullptr) {
+			_pending = job;
+			job = nullptr;
+		}
+	}
+	if (job != nullptr) {
+		releaseJob(job);
+		return false;
+	}
+	if (!_timerInstalled)
+		flush();
+	return true;
+}
+
+bool AsyncSaveWriter::isBusy() {
+	Common::StackLock lock(_mutex);
+	return _pending != nullptr || _writing != nullptr;
+}
+
+void AsyncSaveWriter::flush() {
+	// Pieces are serialised by the I/O mutex, so this finishes the job whoever started it
+	while (isBusy())
+		writeStep();
+}
+
+bool AsyncSaveWriter::takeWritten(int &slot, Common::String &desc) {
+	Common::StackLock lock(_mutex);
+	if (_written.empty())
+		return false;
+	slot = _written.front().slot;
+	desc = _written.front().desc;
+	_written.remove_at(0);
+	return true;
+}
+
+bool AsyncSaveWriter::copyThumbnail(Graphics::Surface &thumb) {
+	Common::StackLock lock(_mutex);
+	if (_writing == nullptr || _writing->thumb == nullptr)
+		return false;
+	thumb.copyFrom(*_writing->thumb);
+	return true;
+}
+
+void AsyncSaveWriter::timerProc(void *refCon) {
+	static_cast<AsyncSaveWriter *>(refCon)->writeStep();
+}
+
+void AsyncSaveWriter::writeStep() {
+	Common::StackLock ioLock(_ioMutex);
+	Job *job;
+	{
+		Common::StackLock lock(_mutex);
+		if (_writing == nullptr) {
+			_writing = _pending;
+			_pending = nullptr;
+		}
+		job = _writing;
+	}
+	if (job == nullptr)
+		return;
+
+	uint32 start = g_system->getMillis();
+	runStage(job);
+	job->writeMs += g_system->getMillis() - start;
+	if (job->stage != kStageDone)
+		return;
+
+	debug(1, "AsyncSaveWriter: wrote %s (%u bytes) in %u ms", job->fileName.c_str(), job->data->size(), job->writeMs);
+	{
+		Common::StackLock lock(_mutex);
+		_writing = nullptr;
+		if (!job->failed) {
+			WrittenSave written;
+			written.slot = job->slot;
+			written.desc = job->desc;
+			_written.push_back(written);
+		}
+	}
+	releaseJob(job);
+}
+
+void AsyncSaveWriter::runStage(Job *job) {
+	switch (job->stage) {
+	case kStageOpen:
+		job->out = g_system->getSavefileManager()->openForSaving(job->fileName);
+		if (job->out == nullptr) {
+			warning("AsyncSaveWriter: could not open %s", job->fileName.c_str());
+			job->failed = true;
+			job->stage = kStageDone;
+		} else {
+			job->stage = kStageData;
+		}
+		break;
+	case kStageData: {
+		uint32 len = MIN<uint32>(kAutosaveChunkSize, job->data->size() - job->written);
+		job->out->write(job->data->getData() + job->written, len);
+		job->written += len;
+		if (job->written >= job->data->size())
+			job->stage = kStageHeader;
+		break;
+	}
+	case kStageHeader:
+		// Asks the meta engine for the thumbnail, which comes from this job
+		MetaEngine::appendExtendedSave(job->out, job->playTime, job->desc, true);
+		job->stage = kStageFinalize;
+		break;
+	case kStageFinalize:
+		job->out->finalize();
+		if (job->out->err()) {
+			warning("AsyncSaveWriter: failed writing %s", job->fileName.c_str());
+			job->failed = true;
+		}
+		delete job->out;
+		job->out = nullptr;
+		job->stage = kStageDone;
+		break;
+	default:
+		break;
+	}
+}
+
+void AsyncSaveWriter::releaseJob(Job *job) {
+	delete job->out;
+	delete job->data;
+	if (job->thumb != nullptr) {
+		job->thumb->free();
+		delete job->thumb;
+	}
+	delete job;
+}
+
+} // End of namespace Pelrock
@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_AUTOSAVE_H
+#define PELROCK_AUTOSAVE_H
+
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/mutex.h"
+#include "common/savefile.h"
+#include "common/scummsys.h"
+#include "common/str.h"
+#include "graphics/surface.h"
+
+namespace Pelrock {
+
+/**
+ * Writes autosaves off the game thread.
+ * The game thread hands over the serialised game state and a thumbnail grabbed from the screen,
+ * which is cheap; compressing, encoding the thumbnail and the file write happen on the timer
+ * thread, a bounded piece per callback so other timers (music decoding) are not held up. One
+ * save is in flight at a time.
+ *
+ * Every piece runs with the I/O mutex held. Game-thread code that goes to the savefile manager
+ * either flushes the writer first (anything that reads save files, which could see this one
+ * half written) or holds getIoMutex() around the call.
+ */
+class AsyncSaveWriter {
+public:
+	AsyncSaveWriter();
+	~AsyncSaveWriter();
+
+	/** Takes ownership of data and thumb. Fails if a save is still being written. */
+	bool submit(int slot, const Common::String &fileName, const Common::String &desc, uint32 playTime,
+				Common::MemoryWriteStreamDynamic *data, Graphics::Surface *thumb);
+	/** Hands out the next save that made it to disk, oldest first, for the game thread to take in. */
+	bool takeWritten(int &slot, Common::String &desc);
+	bool isBusy();
+	/** Writes any pending save on the calling thread, for anything that must see it on disk. */
+	void flush();
+	/** Held while the writer is in the savefile manager; take it around other savefile calls. */
+	Common::Mutex &getIoMutex() { return _ioMutex; }
+	/** The thumbnail of the save being written, asked for by the extended save header. */
+	bool copyThumbnail(Graphics::Surface &thumb);
+
+private:
+	enum JobStage {
+		kStageOpen,
+		kStageData,
+		kStageHeader,
+		kStageFinalize,
+		kStageDone
+	};
+
+	struct Job {
+		int slot = -1;
+		Common::String fileName;
+		Common::String desc;
+		uint32 playTime = 0;
+		Common::MemoryWriteStreamDynamic *data = nullptr;
+		Graphics::Surface *thumb = nullptr;
+		JobStage stage = kStageOpen;
+		Common::OutSaveFile *out = nullptr;
+		uint32 written = 0;  // bytes of data handed to out so far
+		uint32 writeMs = 0;  // time spent in the pieces, for the debug line
+		bool failed = false;
+	};
+
+	struct WrittenSave {
+		int slot;
+		Common::String desc;
+	};
+
+	static void timerProc(void *refCon);
+	/** Writes the next piece of the current job, picking up the pending one if nothing is being written. */
+	void writeStep();
+	/** Moves job on by one stage, or one chunk of its data. */
+	void runStage(Job *job);
+	static void releaseJob(Job *job);
+
+	Common::Mutex _ioMutex; // taken before _mutex, never inside it
+	Common::Mutex _mutex;
+	Job *_pending = nullptr;
+	Job *_writing = nullptr;
+	Common::Array<WrittenSave> _written;
+	bool _timerInstalled = false;
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_AUTOSAVE_H
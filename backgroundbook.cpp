@@ -55,7 +55,7 @@ void BackgroundBook::run() {
 		drawScreen();
 		g_engine->_screen->markAllDirty();
 		g_engine->_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 	g_engine->_screen->clear(0);
 	g_system->getPaletteManager()->setPalette(g_engine->_room->_roomPalette, 0, 256);
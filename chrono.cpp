@@ -28,24 +28,72 @@
 
 namespace Pelrock {
 
-ChronoManager::ChronoManager(/* args */) : _lastTick(0) {
+ChronoManager::ChronoManager(/* args */) : _lastUpdate(0) {
 }
 
 ChronoManager::~ChronoManager() {
 }
 
-void ChronoManager::updateChrono() {
-	uint32 currentTime = g_system->getMillis();
+uint32 ChronoManager::getMillis() const {
+	if (_fastForward)
+		return _virtualTime;
+	return g_system->getMillis() + _clockOffset;
+}
 
-	if ((currentTime - _lastTick) >= kTickMs / _speedMultiplier) {
-		_gameTick = true;
-		if (!_pauseCounter) {
-			_frameCount++;
-		}
-		_lastTick = currentTime;
+void ChronoManager::setFastForward(bool enable) {
+	if (enable == _fastForward)
+		return;
+	if (enable) {
+		_virtualTime = getMillis();
 	} else {
-		_gameTick = false;
+		_clockOffset = _virtualTime - g_system->getMillis();
 	}
+	_fastForward = enable;
+}
+
+void ChronoManager::sleep(uint32 ms) {
+	if (_fastForward)
+		_virtualTime += ms;
+	else
+		g_system->delayMillis(ms);
+}
+
+void ChronoManager::updateChrono() {
+	uint32 currentTime = getMillis();
+
+	// Time is kept scaled by the speed multiplier so 4x ticks every 13.75 ms on average instead of 13
+	_accumulator += (currentTime - _lastUpdate) * _speedMultiplier;
+	_lastUpdate = currentTime;
+	_pendingTicks += _accumulator / kTickMs;
+	_accumulator %= kTickMs;
+	if (_pendingTicks > kMaxCatchUpTicks) {
+		// Not lateness but a stall (debugger, menu, window drag, long load): resume from here
+		// rather than replaying everything that was missed
+		debug(3, "Dropping %u late ticks", _pendingTicks - 1);
+		_pendingTicks = 1;
+	}
+
+	_gameTick = consumeCatchUpTick();
+}
+
+bool ChronoManager::consumeCatchUpTick() {
+	if (_pendingTicks == 0)
+		return false;
+	_pendingTicks--;
+	_tickCount++;
+	if (!_pauseCounter) {
+		_frameCount++;
+	}
+	return true;
+}
+
+uint32 ChronoManager::getTimeToNextTick() const {
+	if (_pendingTicks > 0)
+		return 0;
+	uint32 elapsed = _accumulator + (getMillis() - _lastUpdate) * _speedMultiplier;
+	if (elapsed >= kTickMs)
+		return 0;
+	return (kTickMs - elapsed + _speedMultiplier - 1) / _speedMultiplier;
 }
 
 void ChronoManager::changeSpeed() {
@@ -56,15 +104,38 @@ void ChronoManager::changeSpeed() {
 }
 
 void ChronoManager::delay(uint32 ms) {
-	uint32 delayStart = g_system->getMillis();
+	uint32 delayStart = getMillis();
 
 	ms = ms / _speedMultiplier;
 	Common::Event e;
-	while ((g_system->getMillis() - delayStart) < ms && !g_engine->shouldQuit()) {
+	if (_fastForward) {
+		while (g_system->getEventManager()->pollEvent(e)) {
+		}
+		_virtualTime += ms;
+		return;
+	}
+	uint32 elapsed = 0;
+	while (elapsed < ms && !g_engine->shouldQuit()) {
 		while (g_system->getEventManager()->pollEvent(e)) {
 		}
 		g_engine->_screen->update();
+		g_system->delayMillis(MIN(ms - elapsed, kIdleSleepMs));
+		elapsed = getMillis() - delayStart;
+	}
+}
+
+void ChronoManager::waitForNextTick() {
+	uint32 remaining = getTimeToNextTick();
+	if (remaining > 0) {
+		if (_fastForward)
+			_virtualTime += remaining;
+		else
+			g_system->delayMillis(MIN(remaining, kMaxTickSleepMs));
 	}
 }
 
+void ChronoManager::idle() {
+	sleep(kIdleSleepMs);
+}
+
 } // End of namespace Pelrock
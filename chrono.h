@@ -27,25 +27,76 @@ namespace Pelrock {
 
 const uint32 kTickMs = 55;
 const int kHalfTickMultiplier = 2;
+const uint32 kMaxTickSleepMs = 16; // longest single sleep while waiting for a tick, keeps input responsive
+const uint32 kIdleSleepMs = 10;
+const uint32 kMaxCatchUpTicks = 5; // falling further behind than this counts as a stall and is not caught up
+const uint32 kFastForwardPresentMs = 100; // real time between screen updates while fast-forwarding
 
 class ChronoManager {
 private:
-	uint32 _lastTick = 0;
+	uint32 _lastUpdate = 0;
+	uint32 _accumulator = 0; // elapsed time not yet turned into ticks, in ms * _speedMultiplier
+	uint32 _pendingTicks = 0;
+	uint32 _tickCount = 0; // every tick ever fired, unlike _frameCount it does not pause
 	uint32 _speedMultiplier = 1;
 	uint32 _frameCount = 0;
 	bool _pauseCounter = false;
+	bool _fastForward = false;
+	uint32 _virtualTime = 0;
+	uint32 _clockOffset = 0;
 
 public:
 	ChronoManager();
 	~ChronoManager();
+	/**
+	 * Turns elapsed time into due ticks and consumes one of them, setting _gameTick. The tick
+	 * grid never moves with lateness: leftover time carries over and ticks still owed fire on
+	 * the following calls, so the game keeps its speed on slow machines.
+	 */
 	void updateChrono();
+	/**
+	 * Consumes one more tick that is already due. Lets the caller run logic for ticks it fell
+	 * behind on before presenting a single frame.
+	 */
+	bool consumeCatchUpTick();
+	uint32 getPendingTicks() const { return _pendingTicks; }
 	void changeSpeed();
 	void delay(uint32 ms);
+	/**
+	 * Game clock in milliseconds. Follows the system clock normally; while fast-forwarding it
+	 * only moves when the engine waits, so every wait completes immediately.
+	 */
+	uint32 getMillis() const;
+	/**
+	 * Sleeps for ms of game time. Used for waits that are not tied to the tick.
+	 */
+	void sleep(uint32 ms);
+	/**
+	 * Runs the game logic as fast as the CPU allows. The clock stays continuous across toggles
+	 * so running timers (dialogue TTL, long clicks) are not cut short or stretched.
+	 */
+	void setFastForward(bool enable);
+	bool isFastForward() const { return _fastForward; }
+	/**
+	 * Sleeps until the next game tick is due, in slices of at most kMaxTickSleepMs so input keeps
+	 * being polled. Returns straight away if the tick is already due. Meant for loops that render
+	 * through renderScene() or call updateChrono() themselves.
+	 */
+	void waitForNextTick();
+	/**
+	 * Yields the CPU in loops that only wait for input or for a sound to end.
+	 */
+	void idle();
+	/**
+	 * Milliseconds until the next tick is due, rounded up.
+	 */
+	uint32 getTimeToNextTick() const;
 	inline void pauseCounter() { _pauseCounter = true; }
 	inline void resumeCounter() { _pauseCounter = false; }
 	uint32 getFrameCount() const {
 		return _frameCount;
 	}
+	uint32 getTickCount() const { return _tickCount; }
 
 	bool _gameTick = false;
 	bool countTextDown = false;
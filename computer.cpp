@@ -147,7 +147,7 @@ int Computer::run() {
 
 		g_engine->_screen->markAllDirty();
 		g_engine->_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 	cleanup();
 	return _memorizedBookIndex;
@@ -21,7 +21,11 @@
 
 #include "console.h"
 
+#include "common/file.h"
+#include "common/random.h"
+
 #include "pelrock/console.h"
+#include "pelrock/pathfinding.h"
 #include "pelrock/types.h"
 
 namespace Pelrock {
@@ -34,6 +38,13 @@ PelrockConsole::PelrockConsole(PelrockEngine *engine) : GUI::Debugger(), _engine
 	registerCmd("getFlag", WRAP_METHOD(PelrockConsole, cmdGetFlag));
 	registerCmd("toJail", WRAP_METHOD(PelrockConsole, cmdToJail));
 	registerCmd("removeSticker", WRAP_METHOD(PelrockConsole, cmdRemoveSticker));
+	registerCmd("pathCheck", WRAP_METHOD(PelrockConsole, cmdPathCheck));
+	registerCmd("fastForward", WRAP_METHOD(PelrockConsole, cmdFastForward));
+	registerCmd("perfStats", WRAP_METHOD(PelrockConsole, cmdPerfStats));
+	registerCmd("memStats", WRAP_METHOD(PelrockConsole, cmdMemStats));
+	registerCmd("snapshot", WRAP_METHOD(PelrockConsole, cmdSnapshot));
+	registerCmd("musicStats", WRAP_METHOD(PelrockConsole, cmdMusicStats));
+	registerCmd("audioStats", WRAP_METHOD(PelrockConsole, cmdAudioStats));
 }
 
 PelrockConsole::~PelrockConsole() {
@@ -121,6 +132,197 @@ bool PelrockConsole::cmdGiveItems(int argc, const char **argv) {
 	return true;
 }
 
+/**
+ * Runs random path queries against the walkboxes of every room as ALFRED.1 defines them, or of one
+ * room. Each batch is timed as a whole, then replayed to validate every result.
+ */
+bool PelrockConsole::cmdPathCheck(int argc, const char **argv) {
+	int iterations = (argc >= 2) ? atoi(argv[1]) : 1000;
+	uint32 seed = (argc >= 3) ? (uint32)atoi(argv[2]) : g_system->getMillis();
+	int firstRoom = 0;
+	int lastRoom = kNumRooms - 1;
+	if (argc >= 4) {
+		firstRoom = lastRoom = atoi(argv[3]);
+		if (firstRoom < 0 || firstRoom >= kNumRooms) {
+			debugPrintf("Usage: pathCheck [iterations] [seed] [room]\n");
+			return true;
+		}
+	}
+	if (iterations <= 0)
+		return true;
+
+	Common::File roomFile;
+	if (!roomFile.open(Common::Path("ALFRED.1"))) {
+		debugPrintf("Could not open ALFRED.1\n");
+		return true;
+	}
+
+	struct Query {
+		int sourceX, sourceY, targetX, targetY;
+	};
+	Common::Array<Query> queries;
+	queries.resize(iterations);
+	Common::Array<WalkBox> walkboxes;
+	// Alfred's default walking speed, which the validation replays the steps at
+	AlfredState alfred;
+	Common::RandomSource rnd("pelrockPathCheck");
+	rnd.setSeed(seed);
+	PathContext context = {nullptr, nullptr, 0, 0, 0};
+	uint32 totalQueries = 0;
+	uint32 totalMs = 0;
+	int totalFailures = 0;
+	for (int room = firstRoom; room <= lastRoom; room++) {
+		g_engine->_room->readDefaultWalkboxes(roomFile, room, walkboxes);
+		if (walkboxes.empty()) {
+			debugPrintf("Room %2d: no walkboxes\n", room);
+			continue;
+		}
+		// Alfred always starts inside a walkbox, the target can be anywhere on screen
+		for (int i = 0; i < iterations; i++) {
+			const WalkBox &box = walkboxes[rnd.getRandomNumber(walkboxes.size() - 1)];
+			queries[i].sourceX = box.x + rnd.getRandomNumber(MAX<int>(box.w, 0));
+			queries[i].sourceY = box.y + rnd.getRandomNumber(MAX<int>(box.h, 0));
+			queries[i].targetX = rnd.getRandomNumber(639);
+			queries[i].targetY = rnd.getRandomNumber(399);
+		}
+
+		uint32 batchStart = g_system->getMillis();
+		for (int i = 0; i < iterations; i++) {
+			const Query &q = queries[i];
+			context.pathLength = 0;
+			context.movementCount = 0;
+			findPath(q.sourceX, q.sourceY, q.targetX, q.targetY, walkboxes, &context);
+		}
+		uint32 batchMs = g_system->getMillis() - batchStart;
+
+		int found = 0;
+		int unreachable = 0;
+		int failures = 0;
+		for (int i = 0; i < iterations; i++) {
+			const Query &q = queries[i];
+			context.pathLength = 0;
+			context.movementCount = 0;
+			if (!findPath(q.sourceX, q.sourceY, q.targetX, q.targetY, walkboxes, &context)) {
+				unreachable++;
+				continue;
+			}
+			found++;
+			Common::String errorMsg;
+			if (!validatePath(walkboxes, &context, q.sourceX, q.sourceY, q.targetX, q.targetY,
+							  alfred.movementSpeedX, alfred.movementSpeedY, errorMsg)) {
+				failures++;
+				debugPrintf("FAIL room %d, %d,%d -> %d,%d: %s\n", room, q.sourceX, q.sourceY, q.targetX, q.targetY, errorMsg.c_str());
+			}
+		}
+		debugPrintf("Room %2d: %d queries in %u ms, %d paths, %d unreachable, %d invalid\n",
+					room, iterations, batchMs, found, unreachable, failures);
+		totalQueries += iterations;
+		totalMs += batchMs;
+		totalFailures += failures;
+	}
+	free(context.pathBuffer);
+	free(context.movementBuffer);
+
+	debugPrintf("Seed %u: %u queries in %u ms (%.0f queries/s), %d invalid\n", seed, totalQueries, totalMs,
+				totalMs ? totalQueries * 1000.0f / totalMs : 0.0f, totalFailures);
+	return true;
+}
+
+/**
+ * Toggles unthrottled game logic. "headless" also stops presenting frames until turned off.
+ */
+bool PelrockConsole::cmdFastForward(int argc, const char **argv) {
+	if (argc >= 2) {
+		Common::String mode(argv[1]);
+		bool enable = mode != "off";
+		g_engine->_screen->setHeadless(mode == "headless");
+		g_engine->_chrono->setFastForward(enable);
+	}
+	debugPrintf("Fast-forward is %s%s\n", g_engine->_chrono->isFastForward() ? "on" : "off",
+				g_engine->_screen->isHeadless() ? " (headless)" : "");
+	return true;
+}
+
+bool PelrockConsole::cmdPerfStats(int argc, const char **argv) {
+	if (argc >= 2 && !strcmp(argv[1], "reset")) {
+		g_engine->_perfStats.clear();
+		return true;
+	}
+	debugPrintf("%s", g_engine->_perfStats.format().c_str());
+	const HoverCache &hover = g_engine->getHoverCache();
+	debugPrintf("Hover cache: %u hits, %u misses\n", hover.hits, hover.misses);
+	return true;
+}
+
+bool PelrockConsole::cmdMemStats(int argc, const char **argv) {
+	if (argc >= 2 && !strcmp(argv[1], "reset")) {
+		g_engine->_memStats.resetCounters();
+		return true;
+	}
+	debugPrintf("%s", g_engine->_memStats.format().c_str());
+	return true;
+}
+
+bool PelrockConsole::cmdSnapshot(int argc, const char **argv) {
+	SnapshotRing &ring = g_engine->_snapshots;
+	if (argc >= 2 && !strcmp(argv[1], "take")) {
+		if (g_engine->takeSnapshot())
+			debugPrintf("Took snapshot %u\n", ring.get(0).id);
+		else
+			debugPrintf("Nothing changed since the last snapshot\n");
+		return true;
+	}
+	if (argc >= 2 && !strcmp(argv[1], "restore")) {
+		uint age = argc >= 3 ? atoi(argv[2]) : 0;
+		if (age >= ring.size()) {
+			debugPrintf("There are only %u snapshots\n", ring.size());
+			return true;
+		}
+		uint32 id = ring.get(age).id;
+		if (g_engine->restoreSnapshot(age))
+			debugPrintf("Restored snapshot %u\n", id);
+		return true;
+	}
+	if (argc >= 2 && !strcmp(argv[1], "rewind")) {
+		if (g_engine->rewindSnapshot())
+			debugPrintf("Rewound to snapshot %u\n", ring.get(0).id);
+		return true;
+	}
+	if (argc >= 2 && !strcmp(argv[1], "clear")) {
+		ring.clear();
+		return true;
+	}
+	if (argc >= 2) {
+		debugPrintf("Usage: snapshot [take|restore <age>|rewind|clear]\n");
+		return true;
+	}
+	for (uint age = 0; age < ring.size(); age++) {
+		const StateSnapshot &snapshot = ring.get(age);
+		uint32 seconds = snapshot.playTime / 1000;
+		debugPrintf("%2u: #%u room %3d at %02u:%02u:%02u, %u bytes (%u stored)\n", age, snapshot.id, snapshot.room,
+					seconds / 3600, seconds / 60 % 60, seconds % 60, snapshot.size, snapshot.data.size());
+	}
+	debugPrintf("%u snapshots, %u bytes stored\n", ring.size(), ring.getStoredBytes());
+	return true;
+}
+
+bool PelrockConsole::cmdMusicStats(int argc, const char **argv) {
+	SoundManager *sound = g_engine->getSoundManager();
+	debugPrintf("Track %d from %s%s\n", sound->getCurrentMusicTrack(), sound->isMusicFromFile() ? "file" : "CD",
+				sound->isPaused() ? ", paused" : "");
+	debugPrintf("Music buffer underruns: %u\n", sound->getMusicUnderruns());
+	return true;
+}
+
+bool PelrockConsole::cmdAudioStats(int argc, const char **argv) {
+	if (argc >= 2 && !strcmp(argv[1], "reset")) {
+		g_engine->getSoundManager()->resetStats();
+		return true;
+	}
+	debugPrintf("%s", g_engine->getSoundManager()->getStats().format().c_str());
+	return true;
+}
+
 bool PelrockConsole::cmdToJail(int argc, const char **argv) {
 	g_engine->toJail();
 	return true;
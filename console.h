@@ -39,6 +39,13 @@ private:
 	bool cmdSetFlag(int argc, const char **argv);
 	bool cmdGetFlag(int argc, const char **argv);
 	bool cmdRemoveSticker(int argc, const char **argv);
+	bool cmdPathCheck(int argc, const char **argv);
+	bool cmdFastForward(int argc, const char **argv);
+	bool cmdPerfStats(int argc, const char **argv);
+	bool cmdMemStats(int argc, const char **argv);
+	bool cmdSnapshot(int argc, const char **argv);
+	bool cmdMusicStats(int argc, const char **argv);
+	bool cmdAudioStats(int argc, const char **argv);
 
 public:
 	PelrockConsole(PelrockEngine *engine);
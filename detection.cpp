@@ -35,6 +35,7 @@ const DebugChannelDef PelrockMetaEngineDetection::debugFlagList[] = {
 	{ Pelrock::kDebugFilePath, "FilePath", "File path debug level" },
 	{ Pelrock::kDebugScan, "Scan", "Scan for unrecognised games" },
 	{ Pelrock::kDebugScript, "Script", "Enable debug script dump" },
+	{ Pelrock::kDebugMemory, "Memory", "Memory accounting: 1 flags per-frame allocations, 2 adds a periodic report" },
 	DEBUG_CHANNEL_END
 };
 
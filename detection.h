@@ -32,6 +32,7 @@ enum PelrockDebugChannels {
 	kDebugScan,
 	kDebugFilePath,
 	kDebugScript,
+	kDebugMemory,
 };
 
 extern const PlainGameDescriptor pelrockGames[];
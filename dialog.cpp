@@ -242,19 +242,16 @@ void DialogManager::displayDialogue(Common::Array<Common::Array<Common::String>>
 	if (dialogueLines.empty()) {
 		return;
 	}
-	_dismissDialog = false;
-	// Clear any existing click state
-	_events->_leftMouseClicked = false;
-	_dialogActive = true;
-	int curPage = 0;
-	bool fromIntro = g_engine->_state->getBoolFlag(FLAG_FROM_INTRO) == true;
-
-	uint32 pageTtlMs = calcPageTtlMs(dialogueLines[curPage]);
-	uint32 pageStartMs = g_system->getMillis();
-
-	if(speakerId != kAlfredColor) {
-		_isNPCTalking = true;
+	if (_startInScene) {
+		// A new scene line replaces the previous one
+		if (_sceneDialogue.isActive)
+			endDialogue(_sceneDialogue);
+		beginDialogue(_sceneDialogue, dialogueLines, speakerId, xBasePos, yBasePos);
+		return;
 	}
+
+	ActiveDialogue dialogue;
+	beginDialogue(dialogue, dialogueLines, speakerId, xBasePos, yBasePos);
 	// Render loop - display text and wait for click or TTL
 	while (!g_engine->shouldQuit()) {
 		_events->pollEvent();
@@ -262,74 +259,136 @@ void DialogManager::displayDialogue(Common::Array<Common::Array<Common::String>>
 		// Render the scene (keeps animations going)
 		g_engine->renderScene(OVERLAY_NONE);
 
-		// Draw the dialogue text on top using speaker ID as color
-		Common::Array<Common::String> textLines = dialogueLines[curPage];
+		drawDialoguePage(dialogue);
+		_screen->update();
 
-		int maxWidth = 0;
-		int height = textLines.size() * 24;
-		for (uint i = 0; i < textLines.size(); i++) {
-			maxWidth = MAX(maxWidth, g_engine->_largeFont->getStringWidth(textLines[i]));
-		}
+		if (!advanceDialogue(dialogue))
+			break;
 
-		int xPos = xBasePos - maxWidth / 2;
-		int yPos = yBasePos - height;
+		g_engine->_chrono->waitForNextTick();
+	}
+	endDialogue(dialogue);
+}
 
-		Graphics::Surface *s = getDialogueSurface(textLines, speakerId);
+void DialogManager::beginDialogue(ActiveDialogue &dialogue, Common::Array<Common::Array<Common::String>> dialogueLines, byte speakerId, int xBasePos, int yBasePos) {
+	_dismissDialog = false;
+	// Clear any existing click state
+	_events->_leftMouseClicked = false;
+	_dialogActive = true;
+	dialogue.isActive = true;
+	dialogue.lines = dialogueLines;
+	dialogue.speakerId = speakerId;
+	dialogue.xBasePos = xBasePos;
+	dialogue.yBasePos = yBasePos;
+	dialogue.sprite = _curSprite;
+	dialogue.curPage = 0;
+	dialogue.fromIntro = g_engine->_state->getBoolFlag(FLAG_FROM_INTRO) == true;
+	dialogue.pageTtlMs = calcPageTtlMs(dialogueLines[0]);
+	dialogue.pageStartMs = g_engine->_chrono->getMillis();
+
+	if (speakerId != kAlfredColor) {
+		_isNPCTalking = true;
+	}
+}
 
-		// Clamp to screen bounds (original game: min Y = 1, max X = 639 - width)
-		xPos = CLIP(xPos, 0, 639 - maxWidth);
-		yPos = CLIP(yPos, 1, 400 - (int)s->getRect().height());
+void DialogManager::drawDialoguePage(const ActiveDialogue &dialogue) {
+	// Draw the dialogue text on top using speaker ID as color
+	const Common::Array<Common::String> &textLines = dialogue.lines[dialogue.curPage];
 
-		if (g_engine->_shakeEffectState.enabled) {
-			xPos -= g_engine->_shakeEffectState.shakeX;
-		}
+	int maxWidth = 0;
+	int height = textLines.size() * 24;
+	for (uint i = 0; i < textLines.size(); i++) {
+		maxWidth = MAX(maxWidth, g_engine->_largeFont->getStringWidth(textLines[i]));
+	}
 
-		_screen->transBlitFrom(*s, s->getRect(), Common::Point(xPos, yPos), 255);
-		// drawPos(_screen, xPos, yPos, speakerId);
+	int xPos = dialogue.xBasePos - maxWidth / 2;
+	int yPos = dialogue.yBasePos - height;
 
-		_screen->markAllDirty();
-		_screen->update();
-		s->free();
-		delete s;
+	Graphics::Surface *s = getDialogueSurface(textLines, dialogue.speakerId);
 
-		// Check if TTL expired for this page (always applies, even for _disableClickToAdvance)
-		bool ttlExpired = !fromIntro && (pageTtlMs > 0) && (g_system->getMillis() - pageStartMs >= pageTtlMs);
+	// Clamp to screen bounds (original game: min Y = 1, max X = 639 - width)
+	xPos = CLIP(xPos, 0, 639 - maxWidth);
+	yPos = CLIP(yPos, 1, 400 - (int)s->getRect().height());
 
-		// Click-to-advance (disabled for special intro sequences)
-		bool clickAdvance = _events->_leftMouseClicked && !_disableClickToAdvance;
-		if (_events->_leftMouseClicked)
-			_events->_leftMouseClicked = false;
+	if (g_engine->_shakeEffectState.enabled) {
+		xPos -= g_engine->_shakeEffectState.shakeX;
+	}
 
-		if (clickAdvance || ttlExpired) {
-			if (curPage < (int)dialogueLines.size() - 1) {
-				curPage++;
-				pageStartMs = g_system->getMillis();
-				pageTtlMs = calcPageTtlMs(dialogueLines[curPage]);
-			} else {
-				_dismissDialog = true;
-			}
-		}
+	_screen->transBlitFrom(*s, s->getRect(), Common::Point(xPos, yPos), 255);
+	// drawPos(_screen, xPos, yPos, speakerId);
 
-		if (_dismissDialog) {
-			_dismissDialog = false;
-			break; // Exit dialogue if dismissed programmatically
-		}
+	_screen->markAllDirty();
+	s->free();
+	delete s;
+}
 
-		if (fromIntro && g_engine->_res->_isSpecialAnimFinished) {
-			// in post-intro, text stops only after the animation is done!
-			break;
+bool DialogManager::advanceDialogue(ActiveDialogue &dialogue) {
+	// Check if TTL expired for this page (always applies, even for _disableClickToAdvance)
+	bool ttlExpired = !dialogue.fromIntro && (dialogue.pageTtlMs > 0) && (g_engine->_chrono->getMillis() - dialogue.pageStartMs >= dialogue.pageTtlMs);
+
+	// Click-to-advance (disabled for special intro sequences)
+	bool clickAdvance = _events->_leftMouseClicked && !_disableClickToAdvance;
+	if (_events->_leftMouseClicked)
+		_events->_leftMouseClicked = false;
+
+	if (clickAdvance || ttlExpired) {
+		if (dialogue.curPage < (int)dialogue.lines.size() - 1) {
+			dialogue.curPage++;
+			dialogue.pageStartMs = g_engine->_chrono->getMillis();
+			dialogue.pageTtlMs = calcPageTtlMs(dialogue.lines[dialogue.curPage]);
+		} else {
+			_dismissDialog = true;
 		}
+	}
 
-		g_system->delayMillis(10);
+	if (_dismissDialog) {
+		_dismissDialog = false;
+		return false; // Exit dialogue if dismissed programmatically
 	}
-	if (_curSprite != nullptr) {
-		_curSprite->isTalking = false;
+
+	if (dialogue.fromIntro && g_engine->_res->_isSpecialAnimFinished) {
+		// in post-intro, text stops only after the animation is done!
+		return false;
 	}
-	_dialogActive = false;
-	_isNPCTalking = false;
+	return true;
+}
+
+void DialogManager::endDialogue(ActiveDialogue &dialogue) {
+	if (dialogue.sprite != nullptr) {
+		dialogue.sprite->isTalking = false;
+	}
+	dialogue.isActive = false;
+	// A blocking line may have been shown over the scene's one
+	_dialogActive = _sceneDialogue.isActive;
+	_isNPCTalking = _sceneDialogue.isActive && _sceneDialogue.speakerId != kAlfredColor;
 	g_engine->_alfredState.setState(ALFRED_IDLE);
 }
 
+void DialogManager::sayInScene(Common::StringArray texts, byte spriteIndex) {
+	_startInScene = true;
+	say(texts, spriteIndex);
+	_startInScene = false;
+}
+
+void DialogManager::sayInScene(Common::StringArray texts, int16 x, int16 y) {
+	_startInScene = true;
+	say(texts, x, y);
+	_startInScene = false;
+}
+
+void DialogManager::updateSceneDialogue() {
+	if (!_sceneDialogue.isActive)
+		return;
+	drawDialoguePage(_sceneDialogue);
+	if (!advanceDialogue(_sceneDialogue))
+		endDialogue(_sceneDialogue);
+}
+
+void DialogManager::stopSceneDialogue() {
+	if (_sceneDialogue.isActive)
+		endDialogue(_sceneDialogue);
+}
+
 void DialogManager::displayDialogue(Common::String text, byte speakerId) {
 	displayDialogue(wordWrap(text), speakerId);
 }
@@ -364,7 +423,7 @@ int DialogManager::selectChoice(Common::Array<Common::String> &choices, Graphics
 			}
 		}
 		g_engine->_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->waitForNextTick();
 	}
 
 	_dialogActive = false;
@@ -555,6 +614,7 @@ void DialogManager::startConversation(const byte *conversationData, uint32 dataS
 		return;
 	}
 	setCurSprite(animSet ? animSet->index : -1);
+	_conversationActive = true;
 
 	// Initialize conversation state
 	ConversationState state = initializeConversation(conversationData, dataSize, npcIndex);
@@ -678,6 +738,7 @@ void DialogManager::startConversation(const byte *conversationData, uint32 dataS
 		}
 	}
 
+	_conversationActive = false;
 	debug("Conversation ended");
 }
 
@@ -71,6 +71,20 @@ struct ConversationEndResult {
 	bool hasAction;
 };
 
+/** A line on screen: its pages, where it is drawn and when the current page times out. */
+struct ActiveDialogue {
+	bool isActive = false;
+	Common::Array<Common::StringArray> lines;
+	byte speakerId = 0;
+	int xBasePos = 0;
+	int yBasePos = 0;
+	Sprite *sprite = nullptr; // talking NPC, if any
+	int curPage = 0;
+	uint32 pageTtlMs = 0;
+	uint32 pageStartMs = 0;
+	bool fromIntro = false;
+};
+
 class DialogManager {
 	const static int kArrowWidth = 8;     // Width of arrow character for scroll
 	const static int kChoicePadding = 16; // padding for the choice text surface
@@ -80,11 +94,18 @@ private:
 	GraphicsManager *_graphics = nullptr;
 	// Current talking sprite, to disable and replace with talking animation
 	Sprite *_curSprite = nullptr;
+	ActiveDialogue _sceneDialogue;
+	bool _startInScene = false; // set by sayInScene() so the say() paths only start the line
 
 	// Private helper functions for conversation parsing
 	void displayDialogue(Common::Array<Common::Array<Common::String>> dialogueLines, byte speakerId);
 	void displayDialogue(Common::Array<Common::Array<Common::String>> dialogueLines, byte speakerId, int xBasePos, int yBasePos);
 	void displayDialogue(Common::String text, byte speakerId);
+	void beginDialogue(ActiveDialogue &dialogue, Common::Array<Common::Array<Common::String>> dialogueLines, byte speakerId, int xBasePos, int yBasePos);
+	void drawDialoguePage(const ActiveDialogue &dialogue);
+	/** Handles clicks and page timeouts. Returns false once the last page is done. */
+	bool advanceDialogue(ActiveDialogue &dialogue);
+	void endDialogue(ActiveDialogue &dialogue);
 	uint32 readTextBlock(const byte *data, uint32 dataSize, uint32 startPos, Common::String &outText, byte &outSpeakerId);
 	uint32 parseChoices(const byte *data, uint32 dataSize, uint32 startPos, Common::Array<ChoiceOption> *outChoices);
 	void setCurSprite(int index);
@@ -116,6 +137,17 @@ public:
 	bool processColorAndTrim(Common::StringArray &lines, byte &speakerId);
 	Graphics::Surface *getDialogueSurface(Common::Array<Common::String> dialogueLines, byte speakerId, Graphics::TextAlign alignment = Graphics::kTextAlignCenter);
 
+	/**
+	 * Start a line without waiting for it. The scene draws and advances it every tick, from
+	 * renderScene, until it is clicked away or times out.
+	 */
+	void sayInScene(Common::StringArray texts, byte spriteIndex = 0);
+	void sayInScene(Common::StringArray texts, int16 x, int16 y);
+	bool isSceneDialogueActive() const { return _sceneDialogue.isActive; }
+	/** Draws the scene's line over the presented frame and moves it on; call once per presented frame. */
+	void updateSceneDialogue();
+	void stopSceneDialogue();
+
 	Common::Array<Common::Array<Common::String>> wordWrap(Common::String text);
 	Common::Array<Common::Array<Common::String>> wordWrap(Common::StringArray texts);
 	Common::Array<ChoiceOption> *_currentChoices = nullptr;
@@ -123,8 +155,10 @@ public:
 	// When true, the goodbye option is suppressed for all conversations in the current room.
 	bool _goodbyeDisabled = false;
 
-	// True while a blocking dialog or conversation is on screen.
+	// True while a dialog or conversation is on screen, blocking or not.
 	bool _dialogActive = false;
+	// True from the start of a conversation to its end, choices and actions included.
+	bool _conversationActive = false;
 	bool _dismissDialog = false; // When true, the current dialog will be dismissed on the next iteration of the conversation loop (used for programmatically closing dialogs, e.g. when exiting a room)
 	bool _disableClickToAdvance = false;
 	bool _isNPCTalking = false;
@@ -32,8 +32,8 @@ PelrockEventManager::PelrockEventManager() {
 
 void PelrockEventManager::pollEvent() {
 
-	Common::EventManager *eventMan = g_engine->_system->getEventManager();
-	while (eventMan->pollEvent(_event)) {
+	_recorder.beginPoll(g_engine->_chrono->getTickCount());
+	while (nextEvent(_event)) {
 		if (isMouseEvent(_event)) {
 			_mouseX = _event.mouse.x;
 			_mouseY = _event.mouse.y;
@@ -46,6 +46,7 @@ void PelrockEventManager::pollEvent() {
 			changeGameSpeed(_event);
 			_lastKeyEvent = _event.kbd.keycode;
 			_lastKeyAscii = _event.kbd.ascii;
+			_lastKeyFlags = _event.kbd.flags;
 			_isKeydown = true;
 			break;
 		case Common::EVENT_KEYUP:
@@ -53,7 +54,7 @@ void PelrockEventManager::pollEvent() {
 			return;
 		case Common::EVENT_LBUTTONDOWN:
 			if (_leftMouseButton == 0) {
-				_clickTime = g_system->getMillis();
+				_clickTime = g_engine->_chrono->getMillis();
 			}
 			_leftMouseButton = 1;
 			_mouseClickX = _event.mouse.x;
@@ -89,7 +90,7 @@ void PelrockEventManager::pollEvent() {
 	}
 
 	if (_leftMouseButton) {
-		uint32 elapsedLongClick = g_system->getMillis() - _clickTime;
+		uint32 elapsedLongClick = g_engine->_chrono->getMillis() - _clickTime;
 		if (elapsedLongClick >= kDoubleClickDelay) {
 			elapsedLongClick = 0;
 			_longClicked = true;
@@ -98,19 +99,43 @@ void PelrockEventManager::pollEvent() {
 	}
 }
 
+bool PelrockEventManager::nextEvent(Common::Event &event) {
+	Common::EventManager *eventMan = g_engine->_system->getEventManager();
+	if (_recorder.getMode() == InputRecorder::kModeReplay) {
+		// Live input is ignored while replaying, except for quitting
+		while (eventMan->pollEvent(event)) {
+			if (event.type == Common::EVENT_QUIT || event.type == Common::EVENT_RETURN_TO_LAUNCHER)
+				return true;
+		}
+		if (_recorder.nextReplayEvent(event))
+			return true;
+		if (_recorder.isReplayFinished()) {
+			_recorder.stop();
+			g_engine->onReplayFinished();
+		}
+		return false;
+	}
+
+	if (!eventMan->pollEvent(event))
+		return false;
+	_recorder.recordEvent(event);
+	return true;
+}
+
 void PelrockEventManager::waitForKey() {
 	bool waitForKey = false;
 	Common::Event e;
 	debug("Waiting for key!");
 	while (!waitForKey && !g_engine->shouldQuit()) {
-		while (g_system->getEventManager()->pollEvent(e)) {
+		_recorder.beginPoll(g_engine->_chrono->getTickCount());
+		while (nextEvent(e)) {
 			if (e.type == Common::EVENT_KEYDOWN) {
 				waitForKey = true;
 			}
 		}
 
 		g_engine->_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 }
 
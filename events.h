@@ -24,6 +24,8 @@
 #include "common/events.h"
 #include "common/scummsys.h"
 
+#include "pelrock/replay.h"
+
 namespace Pelrock {
 static const int kDoubleClickDelay = 300; // in milliseconds
 class PelrockEventManager {
@@ -31,6 +33,8 @@ private:
 	Common::Event _event;
 	uint32 _clickTime = 0;
 
+	bool nextEvent(Common::Event &event);
+
 public:
 	int16 _mouseX = 0;
 	int16 _mouseY = 0;
@@ -47,8 +51,10 @@ public:
 	bool _isKeydown = false;
 	Common::KeyCode _lastKeyEvent = Common::KEYCODE_INVALID;
 	uint16 _lastKeyAscii = 0;
+	byte _lastKeyFlags = 0;
 	PelrockEventManager();
 	void pollEvent();
+	InputRecorder _recorder;
 	void waitForKey();
 };
 
@@ -31,6 +31,18 @@
 
 namespace Pelrock {
 
+void PelrockScreen::update() {
+	if (g_engine->_chrono->isFastForward()) {
+		if (_headless)
+			return;
+		uint32 now = g_system->getMillis();
+		if (now - _lastPresent < kFastForwardPresentMs)
+			return;
+		_lastPresent = now;
+	}
+	Graphics::Screen::update();
+}
+
 GraphicsManager::GraphicsManager() {
 }
 
@@ -50,36 +62,35 @@ Common::Point GraphicsManager::showOverlay(int height, Graphics::ManagedSurface
 }
 
 void GraphicsManager::fadeToBlack(int stepSize) {
-	byte palette[768];
-	g_system->getPaletteManager()->grabPalette(palette, 0, 256);
 	while (!g_engine->shouldQuit()) {
 		g_engine->_events->pollEvent();
 		g_engine->_chrono->updateChrono();
 		if (g_engine->_chrono->_gameTick) {
-
-			for (int i = 0; i < 768; i++) {
-				if (palette[i] > 0) {
-					palette[i] = MAX(palette[i] - stepSize, 0);
-				}
-			}
-			g_system->getPaletteManager()->setPalette(palette, 0, 256);
-
-			bool allBlack = true;
-			for (int i = 0; i < 768; i++) {
-				if (palette[i] != 0) {
-					allBlack = false;
-				}
-			}
-
-			if (allBlack) {
+			if (fadeToBlackStep(stepSize)) {
 				break;
 			}
 
 			g_engine->_screen->markAllDirty();
 			g_engine->_screen->update();
 		}
-		g_system->delayMillis(10);
+		g_engine->_chrono->waitForNextTick();
+	}
+}
+
+bool GraphicsManager::fadeToBlackStep(int stepSize) {
+	byte palette[768];
+	g_system->getPaletteManager()->grabPalette(palette, 0, 256);
+	bool allBlack = true;
+	for (int i = 0; i < 768; i++) {
+		if (palette[i] > 0) {
+			palette[i] = MAX(palette[i] - stepSize, 0);
+		}
+		if (palette[i] != 0) {
+			allBlack = false;
+		}
 	}
+	g_system->getPaletteManager()->setPalette(palette, 0, 256);
+	return allBlack;
 }
 
 /**
@@ -92,16 +103,17 @@ void GraphicsManager::fadePaletteToTarget(byte *targetPalette, int stepSize) {
 	while (!g_engine->shouldQuit()) {
 		g_engine->_events->pollEvent();
 
-		bool didRender = g_engine->renderScene(OVERLAY_NONE);
-		if (didRender) {
+		int ticks = g_engine->renderScene(OVERLAY_NONE);
+		if (ticks) {
 			bool changed = false;
+			int step = stepSize * ticks;
 
 			for (int i = 0; i < 768; i++) {
 				if (currentPalette[i] < targetPalette[i]) {
-					currentPalette[i] = MIN((int)currentPalette[i] + stepSize, (int)targetPalette[i]);
+					currentPalette[i] = MIN((int)currentPalette[i] + step, (int)targetPalette[i]);
 					changed = true;
 				} else if (currentPalette[i] > targetPalette[i]) {
-					currentPalette[i] = MAX((int)currentPalette[i] - stepSize, (int)targetPalette[i]);
+					currentPalette[i] = MAX((int)currentPalette[i] - step, (int)targetPalette[i]);
 					changed = true;
 				}
 			}
@@ -113,7 +125,7 @@ void GraphicsManager::fadePaletteToTarget(byte *targetPalette, int stepSize) {
 		}
 
 		g_engine->_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->waitForNextTick();
 	}
 
 	memcpy(g_engine->_room->_roomPalette, targetPalette, 768);
@@ -403,7 +415,7 @@ ScaleCalculation GraphicsManager::calculateScaling(int yPos, ScalingParams scali
 	return scaleCalc;
 }
 
-byte *GraphicsManager::scale(int scaleY, int finalWidth, int finalHeight, byte *buf) {
+void GraphicsManager::scale(int scaleY, int finalWidth, int finalHeight, const byte *buf, byte *out) {
 	// The table marks which source rows to skip: non-zero = skip.
 	int scaleIndex = scaleY;
 	if (scaleIndex >= (int)_heightScalingTable.size()) {
@@ -413,8 +425,7 @@ byte *GraphicsManager::scale(int scaleY, int finalWidth, int finalHeight, byte *
 		scaleIndex = 0;
 	}
 
-	byte *finalBuf = new byte[finalWidth * finalHeight];
-	memset(finalBuf, 255, finalWidth * finalHeight);
+	memset(out, 255, finalWidth * finalHeight);
 
 	if (scaleIndex > 0) {
 		int outY = 0;
@@ -429,14 +440,13 @@ byte *GraphicsManager::scale(int scaleY, int finalWidth, int finalHeight, byte *
 				if (srcX >= kAlfredFrameWidth) {
 					srcX = kAlfredFrameWidth - 1;
 				}
-				finalBuf[outY * finalWidth + outX] = buf[srcY * kAlfredFrameWidth + srcX];
+				out[outY * finalWidth + outX] = buf[srcY * kAlfredFrameWidth + srcX];
 			}
 			outY++;
 		}
 	} else {
-		Common::copy(buf, buf + (kAlfredFrameWidth * kAlfredFrameHeight), finalBuf);
+		Common::copy(buf, buf + (kAlfredFrameWidth * kAlfredFrameHeight), out);
 	}
-	return finalBuf;
 }
 
 } // End of namespace Pelrock
@@ -33,6 +33,21 @@
 
 namespace Pelrock {
 
+/**
+ * Game screen. While the chrono is fast-forwarding, updates reaching the backend are decimated
+ * to one every kFastForwardPresentMs of real time, or dropped entirely in headless mode.
+ */
+class PelrockScreen : public Graphics::Screen {
+public:
+	void update() override;
+	void setHeadless(bool headless) { _headless = headless; }
+	bool isHeadless() const { return _headless; }
+
+private:
+	bool _headless = false;
+	uint32 _lastPresent = 0;
+};
+
 class GraphicsManager {
 public:
 	GraphicsManager();
@@ -41,6 +56,8 @@ public:
 	// Overlay / palette utilities
 	Common::Point showOverlay(int height, Graphics::ManagedSurface &buf);
 	void fadeToBlack(int stepSize);
+	/** Darkens the current palette by one step; returns true once it is all black. */
+	bool fadeToBlackStep(int stepSize);
 	void fadePaletteToTarget(byte *targetPalette, int stepSize);
 	void clearScreen();
 
@@ -76,9 +93,9 @@ public:
 	/**
 	 * Scales a source frame (kAlfredFrameWidth × kAlfredFrameHeight) to
 	 * (finalWidth × finalHeight) using the pre-computed scaling tables.
-	 * Caller owns the returned buffer.
+	 * out must hold finalWidth × finalHeight bytes.
 	 */
-	byte *scale(int scaleY, int finalWidth, int finalHeight, byte *buf);
+	void scale(int scaleY, int finalWidth, int finalHeight, const byte *buf, byte *out);
 
 	// Scaling look-up tables initialized by calculateScalingMasks().
 	Common::Array<Common::Array<int>> _widthScalingTable;
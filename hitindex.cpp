@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/util.h"
+
+#include "pelrock/hitindex.h"
+
+namespace Pelrock {
+
+int HitIndex::cellFor(int x, int y) {
+	// Out of screen points are clamped to the border cells; insert() clamps the same way
+	// so anything overlapping the point is still found there.
+	int cx = CLIP(x / kHitCellSize, 0, kHitCellsX - 1);
+	int cy = CLIP(y / kHitCellSize, 0, kHitCellsY - 1);
+	return cy * kHitCellsX + cx;
+}
+
+void HitIndex::insert(Common::Array<byte> *cells, byte value, int x1, int y1, int x2, int y2) {
+	int first = cellFor(x1, y1);
+	int last = cellFor(x2, y2);
+	for (int cy = first / kHitCellsX; cy <= last / kHitCellsX; cy++) {
+		for (int cx = first % kHitCellsX; cx <= last % kHitCellsX; cx++) {
+			cells[cy * kHitCellsX + cx].push_back(value);
+		}
+	}
+}
+
+void HitIndex::clear() {
+	for (int i = 0; i < kHitCellsX * kHitCellsY; i++) {
+		_hotspotCells[i].clear();
+		_exitCells[i].clear();
+		_walkboxCells[i].clear();
+	}
+	_dirty = true;
+}
+
+void HitIndex::build(const Common::Array<HotSpot> &hotspots, const Common::Array<Exit> &exits, const Common::Array<WalkBox> &walkboxes) {
+	clear();
+	// Bounds mirror the comparisons done by the exact tests: hotspots and walkboxes
+	// include their right/bottom edge, exits do not.
+	for (uint i = 0; i < hotspots.size(); i++) {
+		const HotSpot &h = hotspots[i];
+		insert(_hotspotCells, i, h.x, h.y, h.x + h.w, h.y + h.h);
+	}
+	for (uint i = 0; i < exits.size(); i++) {
+		const Exit &e = exits[i];
+		insert(_exitCells, i, e.x, e.y, e.x + e.w - 1, e.y + e.h - 1);
+	}
+	for (uint i = 0; i < walkboxes.size(); i++) {
+		const WalkBox &w = walkboxes[i];
+		insert(_walkboxCells, i, w.x, w.y, w.x + w.w, w.y + w.h);
+	}
+	_dirty = false;
+}
+
+void buildAnimHitMasks(Anim &anim, int w, int h) {
+	freeAnimHitMasks(anim);
+	if (anim.nframes <= 0 || w <= 0 || h <= 0)
+		return;
+	anim.hitMasks = new HitMask[anim.nframes];
+	anim.numHitMasks = anim.nframes;
+	for (int i = 0; i < anim.nframes; i++) {
+		anim.hitMasks[i].build(anim.animData[i], w, h);
+	}
+}
+
+void setAnimFrame(Anim &anim, int frame, byte *pixels, int w, int h) {
+	anim.animData[frame] = pixels;
+	if (frame < anim.numHitMasks)
+		anim.hitMasks[frame].build(pixels, w, h);
+	else
+		buildAnimHitMasks(anim, w, h);
+}
+
+void freeAnimHitMasks(Anim &anim) {
+	for (int i = 0; i < anim.numHitMasks; i++) {
+		anim.hitMasks[i].release();
+	}
+	delete[] anim.hitMasks;
+	anim.hitMasks = nullptr;
+	anim.numHitMasks = 0;
+}
+
+} // End of namespace Pelrock
@@ -0,0 +1,78 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_HITINDEX_H
+#define PELROCK_HITINDEX_H
+
+#include "common/array.h"
+#include "common/scummsys.h"
+
+#include "pelrock/types.h"
+
+namespace Pelrock {
+
+static const int kHitCellSize = 40;
+static const int kHitCellsX = 640 / kHitCellSize;
+static const int kHitCellsY = 400 / kHitCellSize;
+
+/**
+ * Coarse uniform grid over the room used to narrow down hit tests.
+ * Each cell stores, in array order, the indices of the hotspots, exits and walkboxes whose
+ * rectangles touch it, so the first exact match in a cell is the same one a linear scan would find.
+ * Only geometry lives here: enabled state is still checked by the callers on the real objects.
+ */
+class HitIndex {
+public:
+	void build(const Common::Array<HotSpot> &hotspots, const Common::Array<Exit> &exits, const Common::Array<WalkBox> &walkboxes);
+	void clear();
+	/**
+	 * Marks the index as stale; it is rebuilt lazily on the next query through RoomManager.
+	 */
+	void invalidate() { _dirty = true; }
+	bool isDirty() const { return _dirty; }
+
+	const Common::Array<byte> &hotspotsAt(int x, int y) const { return _hotspotCells[cellFor(x, y)]; }
+	const Common::Array<byte> &exitsAt(int x, int y) const { return _exitCells[cellFor(x, y)]; }
+	const Common::Array<byte> &walkboxesAt(int x, int y) const { return _walkboxCells[cellFor(x, y)]; }
+
+private:
+	static int cellFor(int x, int y);
+	static void insert(Common::Array<byte> *cells, byte value, int x1, int y1, int x2, int y2);
+
+	Common::Array<byte> _hotspotCells[kHitCellsX * kHitCellsY];
+	Common::Array<byte> _exitCells[kHitCellsX * kHitCellsY];
+	Common::Array<byte> _walkboxCells[kHitCellsX * kHitCellsY];
+	bool _dirty = true;
+};
+
+/**
+ * Builds one hit mask per frame of the given anim, replacing any previous ones.
+ */
+void buildAnimHitMasks(Anim &anim, int w, int h);
+void freeAnimHitMasks(Anim &anim);
+/**
+ * Replaces one frame's pixels and rebuilds its hit mask, so picking follows what is drawn.
+ * Use this rather than assigning animData[frame] directly.
+ */
+void setAnimFrame(Anim &anim, int frame, byte *pixels, int w, int h);
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_HITINDEX_H
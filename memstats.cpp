@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/textconsole.h"
+
+#include "pelrock/memstats.h"
+
+namespace Pelrock {
+
+static const char *const kMemTagNames[kMemTagCount] = {
+	"Room",
+	"Resources",
+	"Video",
+	"Sound",
+	"Menu",
+	"Snapshots"
+};
+
+void MemoryStats::add(MemTag tag, uint32 size) {
+	if (size == 0)
+		return;
+	MemTagStats &stats = _stats[tag];
+	stats.liveBytes += size;
+	stats.allocCount++;
+	if (stats.liveBytes > stats.peakBytes)
+		stats.peakBytes = stats.liveBytes;
+	if (_inFrame)
+		stats.frameAllocs++;
+}
+
+void MemoryStats::remove(MemTag tag, uint32 size) {
+	if (size == 0)
+		return;
+	MemTagStats &stats = _stats[tag];
+	if (size > stats.liveBytes) {
+		warning("MemoryStats: %s frees %u bytes but only %u are live", tagName(tag), size, stats.liveBytes);
+		size = stats.liveBytes;
+	}
+	stats.liveBytes -= size;
+	stats.freeCount++;
+}
+
+void MemoryStats::handOff(MemTag tag, uint32 size) {
+	if (size == 0)
+		return;
+	MemTagStats &stats = _stats[tag];
+	stats.handOffCount++;
+	stats.handOffBytes += size;
+	if (_inFrame)
+		stats.frameAllocs++;
+}
+
+void MemoryStats::beginFrame() {
+	for (int i = 0; i < kMemTagCount; i++) {
+		_stats[i].frameAllocs = 0;
+	}
+	_inFrame = true;
+}
+
+uint32 MemoryStats::endFrame() {
+	_inFrame = false;
+	uint32 total = 0;
+	for (int i = 0; i < kMemTagCount; i++) {
+		total += _stats[i].frameAllocs;
+	}
+	return total;
+}
+
+uint32 MemoryStats::getTotalLive() const {
+	uint32 total = 0;
+	for (int i = 0; i < kMemTagCount; i++) {
+		total += _stats[i].liveBytes;
+	}
+	return total;
+}
+
+void MemoryStats::resetCounters() {
+	for (int i = 0; i < kMemTagCount; i++) {
+		MemTagStats &stats = _stats[i];
+		stats.peakBytes = stats.liveBytes;
+		stats.allocCount = 0;
+		stats.freeCount = 0;
+		stats.handOffCount = 0;
+		stats.handOffBytes = 0;
+	}
+}
+
+const char *MemoryStats::tagName(MemTag tag) {
+	return kMemTagNames[tag];
+}
+
+Common::String MemoryStats::format() const {
+	Common::String out;
+	uint32 peakSum = 0;
+	for (int i = 0; i < kMemTagCount; i++) {
+		const MemTagStats &stats = _stats[i];
+		out += Common::String::format("%-9s: %8u live, %8u peak | %6u allocs, %6u frees, %6u handed off (%u bytes)\n",
+									  kMemTagNames[i], stats.liveBytes, stats.peakBytes, stats.allocCount,
+									  stats.freeCount, stats.handOffCount, stats.handOffBytes);
+		peakSum += stats.peakBytes;
+	}
+	// Tags peak at different times, so the sum of the peaks is only an upper bound
+	out += Common::String::format("Total    : %8u live, %8u sum of peaks\n", getTotalLive(), peakSum);
+	return out;
+}
+
+Common::String MemoryStats::formatFrame() const {
+	Common::String out;
+	for (int i = 0; i < kMemTagCount; i++) {
+		if (_stats[i].frameAllocs == 0)
+			continue;
+		if (!out.empty())
+			out += ", ";
+		out += Common::String::format("%s %u", kMemTagNames[i], _stats[i].frameAllocs);
+	}
+	return out;
+}
+
+} // End of namespace Pelrock
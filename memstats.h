@@ -0,0 +1,85 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_MEMSTATS_H
+#define PELROCK_MEMSTATS_H
+
+#include "common/scummsys.h"
+#include "common/str.h"
+
+namespace Pelrock {
+
+enum MemTag {
+	kMemRoom,
+	kMemResources,
+	kMemVideo,
+	kMemSound,
+	kMemMenu,
+	kMemSnapshots,
+	kMemTagCount
+};
+
+struct MemTagStats {
+	uint32 liveBytes = 0;
+	uint32 peakBytes = 0;
+	uint32 allocCount = 0;
+	uint32 freeCount = 0;
+	/** Buffers allocated here whose ownership moved elsewhere, e.g. to an audio stream. */
+	uint32 handOffCount = 0;
+	uint32 handOffBytes = 0;
+	/** Allocations made since the current frame began. */
+	uint32 frameAllocs = 0;
+};
+
+/**
+ * Accounting for the engine's large buffers, per owning subsystem.
+ * Owners report their buffers where they allocate and free them, whatever allocator they use,
+ * so this tracks what the engine holds rather than every heap call.
+ */
+class MemoryStats {
+public:
+	void add(MemTag tag, uint32 size);
+	void remove(MemTag tag, uint32 size);
+	/** Counts an allocation whose buffer is freed by someone else. */
+	void handOff(MemTag tag, uint32 size);
+
+	/** Brackets a rendered frame; endFrame() returns how many allocations it made. */
+	void beginFrame();
+	uint32 endFrame();
+
+	const MemTagStats &get(MemTag tag) const { return _stats[tag]; }
+	uint32 getTotalLive() const;
+	/** Clears the counters and brings the high-water marks down to the live sizes. */
+	void resetCounters();
+
+	static const char *tagName(MemTag tag);
+	/** One line per tag plus a total. */
+	Common::String format() const;
+	/** The tags that allocated during the last frame, e.g. "Video 2, Sound 1". */
+	Common::String formatFrame() const;
+
+private:
+	MemTagStats _stats[kMemTagCount];
+	bool _inFrame = false;
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_MEMSTATS_H
@@ -338,7 +338,7 @@ bool MenuManager::checkMouseClick(int x, int y) {
 			break;
 		}
 		if (_savesDown.contains(x, y)) {
-			if ((_saveGamePage + 1) * 8 < 256) {
+			if ((_saveGamePage + 1) * 8 < kNumSaveSlots) {
 				_saveGamePage++;
 				_editingSaveSlot = -1;
 			}
@@ -355,7 +355,7 @@ bool MenuManager::checkMouseClick(int x, int y) {
 			if (_saveSlotRects[i].contains(x, y)) {
 				int slot = _saveGamePage * 8 + i;
 				_editingSaveSlot = slot;
-				_editingName = _saveDescriptions[slot];
+				_editingName = g_engine->_saveSlots.getDescription(slot);
 				break;
 			}
 		}
@@ -369,7 +369,7 @@ bool MenuManager::checkMouseClick(int x, int y) {
 			break;
 		}
 		if (_savesDown.contains(x, y)) {
-			if ((_saveGamePage + 1) * 8 < 256)
+			if ((_saveGamePage + 1) * 8 < kNumSaveSlots)
 				_saveGamePage++;
 			break;
 		}
@@ -382,7 +382,7 @@ bool MenuManager::checkMouseClick(int x, int y) {
 		for (int i = 0; i < (int)_saveSlotRects.size(); i++) {
 			if (_saveSlotRects[i].contains(x, y)) {
 				int slot = _saveGamePage * 8 + i;
-				if (!_saveDescriptions[slot].empty()) {
+				if (g_engine->_saveSlots.isUsed(slot)) {
 					g_engine->loadGameState(slot);
 					backToMainMenu();
 					return true;
@@ -456,7 +456,6 @@ bool MenuManager::checkMainMenuMouse(int x, int y) {
 		if (ConfMan.getBool("original_menus") == true) {
 			_saveGamePage = 0;
 			_editingSaveSlot = -1;
-			refreshSaveDescriptions();
 			_menuState = ORIGINAL_SAVE;
 			_menuText = Common::StringArray();
 		} else {
@@ -467,7 +466,6 @@ bool MenuManager::checkMainMenuMouse(int x, int y) {
 		_sound->playSound("11ZZZZZZ.SMP", 0);
 		if (ConfMan.getBool("original_menus") == true) {
 			_saveGamePage = 0;
-			refreshSaveDescriptions();
 			_menuState = ORIGINAL_LOAD;
 			_menuText = Common::StringArray();
 		} else {
@@ -524,7 +522,7 @@ void MenuManager::showCredits() {
 		_events->pollEvent();
 		_screen->markAllDirty();
 		_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 }
 
@@ -551,7 +549,6 @@ void MenuManager::handleSaveMenuKey(Common::KeyCode key, uint16 ascii) {
 	if (key == Common::KEYCODE_RETURN || key == Common::KEYCODE_KP_ENTER) {
 		// Commit save
 		g_engine->saveGameState(_editingSaveSlot, _editingName);
-		_saveDescriptions[_editingSaveSlot] = _editingName;
 		_editingSaveSlot = -1;
 		backToMainMenu();
 	} else if (key == Common::KEYCODE_BACKSPACE) {
@@ -633,7 +630,7 @@ void MenuManager::menuLoop() {
 		drawScreen();
 		_screen->markAllDirty();
 		_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 	g_engine->_graphics->clearScreen();
 	_events->_rightMouseClicked = false;
@@ -690,6 +687,7 @@ void MenuManager::loadMenu() {
 
 	_compositeBuffer.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
 	_mainMenu.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
+	_residentBytes += 2 * 640 * 400;
 	loadMenuTexts();
 	alfred7.seek(kSettingsPaletteOffset, SEEK_SET);
 	alfred7.read(_mainMenuPalette, 768);
@@ -769,6 +767,8 @@ void MenuManager::loadMenu() {
 	_soundControlMusicIcon = new byte[66 * 64];
 	extractSingleFrame(soundIconMusicData, _soundControlMusicIcon, 0, 66, 64);
 	free(soundIconMusicData);
+	_residentBytes += 3 * 66 * 64;
+	g_engine->_memStats.add(kMemMenu, _residentBytes);
 
 	_menuText = _menuTexts[0];
 	alfred7.close();
@@ -783,6 +783,7 @@ void MenuManager::readButton(byte *rawData, uint32 offset, byte *outBuffer[2], i
 	byte *buttonData = new byte[w * h * 2];
 	outBuffer[0] = new byte[w * h];
 	outBuffer[1] = new byte[w * h];
+	_residentBytes += w * h * 2;
 	Common::copy(rawData + offset, rawData + offset + w * h * 2, buttonData);
 	extractSingleFrame(buttonData, outBuffer[0], 0, w, h);
 	extractSingleFrame(buttonData, outBuffer[1], 1, w, h);
@@ -794,6 +795,7 @@ void MenuManager::readButton(Common::File &alfred7, uint32 offset, byte *outBuff
 	byte *buttonData = new byte[rect.width() * rect.height() * 2];
 	outBuffer[0] = new byte[rect.width() * rect.height()];
 	outBuffer[1] = new byte[rect.width() * rect.height()];
+	_residentBytes += rect.width() * rect.height() * 2;
 	alfred7.read(buttonData, rect.width() * rect.height() * 2);
 
 	extractSingleFrame(buttonData, outBuffer[0], 0, rect.width(), rect.height());
@@ -870,17 +872,6 @@ void MenuManager::drawConfirmation() {
 	_menuText = _menuTexts[5];
 }
 
-void MenuManager::refreshSaveDescriptions() {
-	_saveDescriptions.clear();
-	_saveDescriptions.resize(256);
-
-	SaveStateList saves = g_engine->getMetaEngine()->listSaves(ConfMan.getActiveDomainName().c_str());
-	for (const SaveStateDescriptor &desc : saves) {
-		int slot = desc.getSaveSlot();
-		if (slot >= 0 && slot < 256)
-			_saveDescriptions[slot] = desc.getDescription();
-	}
-}
 void MenuManager::drawSaves() {
 
 	// Compute the area for the overlay
@@ -917,7 +908,7 @@ void MenuManager::drawSaves() {
 			slotText = _editingName;
 			textColor = 18; // highlight colour for active editing
 		} else {
-			const Common::String &desc = _saveDescriptions[slot];
+			const Common::String &desc = g_engine->_saveSlots.getDescription(slot);
 			if (desc.empty())
 				slotText = Common::String::format("%s", _menuTexts[1][0].c_str());
 			else {
@@ -1029,6 +1020,7 @@ Pelrock::MenuManager::~MenuManager() {
 	delete[] _soundControlMasterIcon;
 	delete[] _soundControlSfxIcon;
 	delete[] _soundControlMusicIcon;
+	g_engine->_memStats.remove(kMemMenu, _residentBytes);
 }
 
 } // End of namespace Pelrock
@@ -127,7 +127,6 @@ private:
 	void drawSoundControls();
 	void readButton(byte *rawData, uint32 offset, byte *outBuffer[2], int w, int h);
 	void readButton(Common::File &alfred7, uint32 offset, byte *outBuffer[2], Common::Rect rect);
-	void refreshSaveDescriptions();
 	void handleSaveMenuKey(Common::KeyCode key, uint16 ascii);
 	void backToMainMenu();
 	SoundMenuButton isSoundMenuButtonUnder(int x, int y);
@@ -181,6 +180,7 @@ private:
 	byte *_soundControlMasterIcon = nullptr;
 	byte *_soundControlSfxIcon = nullptr;
 	byte *_soundControlMusicIcon = nullptr;
+	uint32 _residentBytes = 0; // everything loadMenu() keeps, as reported to the memory stats
 
 	Graphics::ManagedSurface _masterSoundIcon;
 	Graphics::ManagedSurface _sfxSoundIcon;
@@ -208,7 +208,6 @@ private:
 	Common::String _editingName;                // name being typed for a save
 	Common::Rect _cancelarRect;                 // hit-rect for the CANCELAR row
 	Common::Array<Common::Rect> _saveSlotRects; // hit-rects for the 8 visible save rows
-	Common::StringArray _saveDescriptions;      // indexed by slot 0-255
 };
 
 } // End of namespace Pelrock
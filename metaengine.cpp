@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/config-manager.h"
 #include "common/translation.h"
 #include "graphics/thumbnail.h"
 
@@ -93,6 +94,10 @@ Common::Error PelrockMetaEngine::createInstance(OSystem *syst, Engine **engine,
 
 void PelrockMetaEngine::getSavegameThumbnail(Graphics::Surface &thumb) {
 	Pelrock::PelrockEngine *engine = static_cast<Pelrock::PelrockEngine *>(g_engine);
+	if (engine && engine->_autosaveWriter.copyThumbnail(thumb)) {
+		// Autosave being written on the timer thread, with the screen as it was when it was taken
+		return;
+	}
 	if (engine && engine->_saveThumbnail.getPixels()) {
 		thumb.copyFrom(engine->_saveThumbnail);
 	} else {
@@ -100,6 +105,16 @@ void PelrockMetaEngine::getSavegameThumbnail(Graphics::Surface &thumb) {
 	}
 }
 
+void PelrockMetaEngine::removeSaveState(const char *target, int slot) const {
+	Pelrock::PelrockEngine *engine = static_cast<Pelrock::PelrockEngine *>(g_engine);
+	// Don't delete a file the autosave writer is still in
+	if (engine)
+		engine->_autosaveWriter.flush();
+	AdvancedMetaEngine::removeSaveState(target, slot);
+	if (engine && ConfMan.getActiveDomainName() == target)
+		engine->_saveSlots.removeSlot(slot);
+}
+
 bool PelrockMetaEngine::hasFeature(MetaEngineFeature f) const {
 	return checkExtendedSaves(f) ||
 		(f == kSupportsLoadingDuringStartup);
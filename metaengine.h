@@ -41,6 +41,9 @@ public:
 	const ADExtraGuiOptionsMap *getAdvancedExtraGuiOptions() const override;
 
 	void getSavegameThumbnail(Graphics::Surface &thumb) override;
+
+	/** Also keeps the running engine's save slot cache in step. */
+	void removeSaveState(const char *target, int slot) const override;
 };
 
 #endif // PELROCK_METAENGINE_H
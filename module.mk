@@ -8,19 +8,29 @@ MODULE_OBJS = \
 	console.o \
 	metaengine.o \
 	room.o \
+	arena.o \
+	hitindex.o \
+	sequences.o \
 	fonts/small_font.o \
 	fonts/large_font.o \
 	fonts/small_font_double.o \
 	util.o \
 	resources.o\
 	sound.o \
+	music.o \
 	video/video.o \
 	pathfinding.o \
+	replay.o \
+	memstats.o \
+	audiocues.o \
 	events.o \
 	dialog.o \
 	menu.o \
 	graphics.o \
 	saveload.o \
+	autosave.o \
+	saveslots.o \
+	snapshots.o \
 	spellbook.o \
 	slidingpuzzle.o \
 	cdplayer.o \
@@ -0,0 +1,223 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "audio/decoders/flac.h"
+#include "audio/decoders/vorbis.h"
+#include "audio/decoders/wave.h"
+#include "common/config-manager.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/system.h"
+#include "common/timer.h"
+
+#include "pelrock/music.h"
+
+namespace Pelrock {
+
+static const int32 kMusicDecodeIntervalUs = 50 * 1000;
+static const uint32 kMusicBufferMs = 1000;
+static const uint32 kMusicDecodeChunk = 4096; // samples, even so stereo frames are never split
+
+BufferedMusicStream::BufferedMusicStream(Audio::AudioStream *source, uint32 bufferSamples)
+	: _source(source), _stereo(source->isStereo()), _rate(source->getRate()) {
+	_capacity = bufferSamples & ~1;
+	_ring = new int16[_capacity];
+	_staging = new int16[kMusicDecodeChunk];
+}
+
+BufferedMusicStream::~BufferedMusicStream() {
+	delete _source;
+	delete[] _ring;
+	delete[] _staging;
+}
+
+void BufferedMusicStream::decodeAhead() {
+	while (true) {
+		uint32 space;
+		{
+			Common::StackLock lock(_mutex);
+			if (_sourceEnded)
+				return;
+			space = _capacity - _fill;
+		}
+		// Only this side adds to the buffer, so the space can only grow while we decode
+		uint32 want = MIN(space, kMusicDecodeChunk) & ~1;
+		if (want == 0)
+			return;
+		int got = _source->readBuffer(_staging, want);
+
+		Common::StackLock lock(_mutex);
+		uint32 writePos = (_readPos + _fill) % _capacity;
+		for (int i = 0; i < got; i++) {
+			_ring[writePos] = _staging[i];
+			writePos = (writePos + 1) % _capacity;
+		}
+		_fill += got;
+		if (got < (int)want && _source->endOfData()) {
+			_sourceEnded = true;
+			return;
+		}
+		if (got <= 0)
+			return;
+	}
+}
+
+uint32 BufferedMusicStream::getUnderruns() {
+	Common::StackLock lock(_mutex);
+	return _underruns;
+}
+
+int BufferedMusicStream::readBuffer(int16 *buffer, const int numSamples) {
+	Common::StackLock lock(_mutex);
+	uint32 count = MIN<uint32>(numSamples, _fill);
+	uint32 firstPart = MIN(count, _capacity - _readPos);
+	memcpy(buffer, _ring + _readPos, firstPart * sizeof(int16));
+	memcpy(buffer + firstPart, _ring, (count - firstPart) * sizeof(int16));
+	_readPos = (_readPos + count) % _capacity;
+	_fill -= count;
+	if (count == (uint32)numSamples || _sourceEnded)
+		return count;
+	// The decoder fell behind: fill the gap with silence and keep going
+	memset(buffer + count, 0, (numSamples - count) * sizeof(int16));
+	_underruns++;
+	return numSamples;
+}
+
+bool BufferedMusicStream::endOfData() const {
+	Common::StackLock lock(_mutex);
+	return _sourceEnded && _fill == 0;
+}
+
+LocalMusicPlayer::LocalMusicPlayer(Audio::Mixer *mixer) : _mixer(mixer) {
+	_timerInstalled = g_system->getTimerManager()->installTimerProc(&timerProc, kMusicDecodeIntervalUs, this, "pelrockMusic");
+}
+
+LocalMusicPlayer::~LocalMusicPlayer() {
+	if (_timerInstalled)
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+	stop();
+}
+
+Audio::SeekableAudioStream *LocalMusicPlayer::openTrack(int track) {
+	static const char *const kNamePatterns[] = {"track%02d", "track%d"};
+	static const char *const kExtensions[] = {"flac", "ogg", "wav"};
+
+	Common::FSNode musicDir;
+	bool hasMusicDir = ConfMan.hasKey("music_path");
+	if (hasMusicDir)
+		musicDir = Common::FSNode(ConfMan.getPath("music_path"));
+
+	for (int p = 0; p < ARRAYSIZE(kNamePatterns); p++) {
+		for (int e = 0; e < ARRAYSIZE(kExtensions); e++) {
+			Common::String name = Common::String::format(kNamePatterns[p], track) + "." + kExtensions[e];
+			Common::SeekableReadStream *file = nullptr;
+			if (hasMusicDir) {
+				Common::FSNode node = musicDir.getChild(name);
+				if (node.exists())
+					file = node.createReadStream();
+			} else {
+				Common::File *gameFile = new Common::File();
+				if (gameFile->open(Common::Path("music").appendComponent(name)))
+					file = gameFile;
+				else
+					delete gameFile;
+			}
+			if (!file)
+				continue;
+
+			if (!strcmp(kExtensions[e], "wav"))
+				return Audio::makeWAVStream(file, DisposeAfterUse::YES);
+#ifdef USE_FLAC
+			if (!strcmp(kExtensions[e], "flac"))
+				return Audio::makeFLACStream(file, DisposeAfterUse::YES);
+#endif
+#ifdef USE_VORBIS
+			if (!strcmp(kExtensions[e], "ogg"))
+				return Audio::makeVorbisStream(file, DisposeAfterUse::YES);
+#endif
+			// Built without a decoder for this one
+			delete file;
+		}
+	}
+	return nullptr;
+}
+
+bool LocalMusicPlayer::play(int track, bool loop) {
+	stop();
+	Audio::SeekableAudioStream *trackStream = openTrack(track);
+	if (!trackStream)
+		return false;
+
+	Audio::AudioStream *source = loop ? Audio::makeLoopingAudioStream(trackStream, 0) : trackStream;
+	uint32 bufferSamples = source->getRate() * (source->isStereo() ? 2 : 1) * kMusicBufferMs / 1000;
+	BufferedMusicStream *stream = new BufferedMusicStream(source, bufferSamples);
+	// Start with a full buffer
+	stream->decodeAhead();
+
+	Common::StackLock lock(_mutex);
+	_stream = stream;
+	// We keep ownership: the timer may still be decoding into it when the mixer lets go
+	_mixer->playStream(Audio::Mixer::kMusicSoundType, &_handle, _stream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO);
+	return true;
+}
+
+void LocalMusicPlayer::stop() {
+	_mixer->stopHandle(_handle);
+	Common::StackLock lock(_mutex);
+	if (_stream) {
+		_pastUnderruns += _stream->getUnderruns();
+		delete _stream;
+		_stream = nullptr;
+	}
+}
+
+void LocalMusicPlayer::pause() {
+	_mixer->pauseHandle(_handle, true);
+}
+
+void LocalMusicPlayer::resume() {
+	_mixer->pauseHandle(_handle, false);
+}
+
+bool LocalMusicPlayer::isLoaded() {
+	Common::StackLock lock(_mutex);
+	return _stream != nullptr;
+}
+
+bool LocalMusicPlayer::isPlaying() {
+	return isLoaded() && _mixer->isSoundHandleActive(_handle);
+}
+
+uint32 LocalMusicPlayer::getUnderruns() {
+	Common::StackLock lock(_mutex);
+	return _pastUnderruns + (_stream ? _stream->getUnderruns() : 0);
+}
+
+void LocalMusicPlayer::timerProc(void *refCon) {
+	static_cast<LocalMusicPlayer *>(refCon)->decodeAhead();
+}
+
+void LocalMusicPlayer::decodeAhead() {
+	Common::StackLock lock(_mutex);
+	if (_stream)
+		_stream->decodeAhead();
+}
+
+} // End of namespace Pelrock
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_MUSIC_H
+#define PELROCK_MUSIC_H
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "common/mutex.h"
+#include "common/scummsys.h"
+
+namespace Pelrock {
+
+/**
+ * Plays a decoded track out of a buffer that is filled ahead of the mixer.
+ * The mixer only ever copies from the buffer; if it finds it short it plays silence for the gap
+ * and counts an underrun rather than waiting on the decoder.
+ */
+class BufferedMusicStream : public Audio::AudioStream {
+public:
+	/** Takes ownership of source. */
+	BufferedMusicStream(Audio::AudioStream *source, uint32 bufferSamples);
+	~BufferedMusicStream() override;
+
+	/** Decodes until the buffer is full or the source ends. Not to be called from the mixer. */
+	void decodeAhead();
+	uint32 getUnderruns();
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override;
+
+private:
+	Audio::AudioStream *_source;
+	bool _stereo;
+	int _rate;
+	int16 *_ring;
+	uint32 _capacity;
+	uint32 _readPos = 0;
+	uint32 _fill = 0;
+	bool _sourceEnded = false;
+	uint32 _underruns = 0;
+	int16 *_staging;
+	mutable Common::Mutex _mutex;
+};
+
+/**
+ * Music from ripped CD tracks, e.g. track05.flac, looked up in the directory set by the
+ * music_path option or else in a music folder of the game. FLAC, Ogg Vorbis and WAV are read.
+ * Looping is done on the decoded stream, so it is sample accurate, and decoding runs on a timer.
+ */
+class LocalMusicPlayer {
+public:
+	explicit LocalMusicPlayer(Audio::Mixer *mixer);
+	~LocalMusicPlayer();
+
+	/** False if there is no file for the track. */
+	bool play(int track, bool loop);
+	void stop();
+	/** Pausing keeps the stream, and with it the decode position. */
+	void pause();
+	void resume();
+	bool isLoaded();
+	bool isPlaying();
+	/** Underruns since the session started, over every track. */
+	uint32 getUnderruns();
+
+private:
+	static Audio::SeekableAudioStream *openTrack(int track);
+	static void timerProc(void *refCon);
+	void decodeAhead();
+
+	Audio::Mixer *_mixer;
+	Audio::SoundHandle _handle;
+	BufferedMusicStream *_stream = nullptr;
+	uint32 _pastUnderruns = 0;
+	bool _timerInstalled = false;
+	Common::Mutex _mutex;
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_MUSIC_H
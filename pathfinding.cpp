@@ -20,6 +20,7 @@
  */
 #include "common/debug.h"
 #include "common/scummsys.h"
+#include "common/textconsole.h"
 
 #include "pelrock/pathfinding.h"
 #include "pelrock/types.h"
@@ -318,6 +319,11 @@ uint16 generateMovementSteps(Common::Array<WalkBox> &walkboxes,
 		calculateMovementToTarget(currentX, currentY, destX, destY, box, &step);
 
 		if (step.distanceX > 0 || step.distanceY > 0) {
+			// The last slot is kept for the final step
+			if (movementIndex >= kMaxMovementSteps - 1) {
+				warning("Path through %d walkboxes needs more than %d steps, cutting it short", pathLength, kMaxMovementSteps);
+				break;
+			}
 			movementBuffer[movementIndex++] = step;
 
 			// Update current position
@@ -366,4 +372,67 @@ uint16 generateMovementSteps(Common::Array<WalkBox> &walkboxes,
 	return movementIndex;
 }
 
+bool validatePath(Common::Array<WalkBox> &walkboxes, PathContext *context, int startX, int startY, int targetX, int targetY,
+				  uint16 speedX, uint16 speedY, Common::String &errorMsg) {
+	Common::Point target = calculateWalkTarget(walkboxes, targetX, targetY, nullptr);
+	byte startBox = findWalkboxForPoint(walkboxes, startX, startY);
+	byte destBox = findWalkboxForPoint(walkboxes, target.x, target.y);
+
+	if (startBox != destBox) {
+		if (context->pathLength == 0 || context->pathLength >= kMaxPathLength) {
+			errorMsg = Common::String::format("path length %d out of range", context->pathLength);
+			return false;
+		}
+		if (context->pathBuffer[context->pathLength] != kPathEnd) {
+			errorMsg = "path is not terminated";
+			return false;
+		}
+		if (context->pathBuffer[0] != startBox || context->pathBuffer[context->pathLength - 1] != destBox) {
+			errorMsg = Common::String::format("path goes from %d to %d, expected %d to %d",
+											  context->pathBuffer[0], context->pathBuffer[context->pathLength - 1], startBox, destBox);
+			return false;
+		}
+		for (uint16 i = 0; i < context->pathLength; i++) {
+			if (context->pathBuffer[i] >= walkboxes.size()) {
+				errorMsg = Common::String::format("walkbox %d at step %d does not exist", context->pathBuffer[i], i);
+				return false;
+			}
+			if (i > 0 && !areWalkboxesAdjacent(&walkboxes[context->pathBuffer[i - 1]], &walkboxes[context->pathBuffer[i]])) {
+				errorMsg = Common::String::format("walkboxes %d and %d are not adjacent", context->pathBuffer[i - 1], context->pathBuffer[i]);
+				return false;
+			}
+		}
+	}
+
+	// Walk the steps the way Alfred does, a frame at a time, and check every position he passes through
+	uint16 x = startX;
+	uint16 y = startY;
+	for (uint16 i = 0; i < context->movementCount; i++) {
+		MovementStep step = context->movementBuffer[i];
+		while (step.distanceX > 0 || step.distanceY > 0) {
+			uint16 dx = MIN(speedX, step.distanceX);
+			uint16 dy = MIN(speedY, step.distanceY);
+			if (step.flags & kMoveRight)
+				x += dx;
+			else if (step.flags & kMoveLeft)
+				x -= dx;
+			if (step.flags & kMoveDown)
+				y += dy;
+			else if (step.flags & kMoveUp)
+				y -= dy;
+			step.distanceX -= dx;
+			step.distanceY -= dy;
+			if (findWalkboxForPoint(walkboxes, x, y) == 0xFF) {
+				errorMsg = Common::String::format("step %d leaves the walkboxes at %d,%d", i, x, y);
+				return false;
+			}
+		}
+	}
+	if (x != (uint16)target.x || y != (uint16)target.y) {
+		errorMsg = Common::String::format("steps end at %d,%d instead of %d,%d", x, y, target.x, target.y);
+		return false;
+	}
+	return true;
+}
+
 } // End of namespace Pelrock
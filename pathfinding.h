@@ -22,6 +22,7 @@
 #define PELROCK_PATHFINDING_H
 
 #include "common/scummsys.h"
+#include "common/str.h"
 #include "graphics/screen.h"
 
 #include "pelrock/types.h"
@@ -45,6 +46,14 @@ uint16 buildWalkboxPath(Common::Array<WalkBox> &walkboxes, byte start_box, byte
 uint16 generateMovementSteps(Common::Array<WalkBox> &walkboxes, byte *path_buffer, uint16 path_length, uint16 start_x, uint16 start_y, uint16 dest_x, uint16 dest_y, MovementStep *movement_buffer);
 bool isPointInWalkbox(WalkBox *box, uint16 x, uint16 y);
 void clearVisitedFlags(Common::Array<WalkBox> &walkboxes);
+/**
+ * Sanity checks the output of a successful findPath call: path bounds, walkbox indices, adjacency
+ * of consecutive walkboxes, that every position Alfred passes through walking the steps at the given
+ * speeds stays inside a walkbox, and that the walk ends on the walk target.
+ * @return                  true if the path is consistent, otherwise false with the reason in errorMsg.
+ */
+bool validatePath(Common::Array<WalkBox> &walkboxes, PathContext *context, int startX, int startY, int targetX, int targetY,
+				  uint16 speedX, uint16 speedY, Common::String &errorMsg);
 
 } // End of namespace Pelrock
 
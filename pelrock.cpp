@@ -20,6 +20,7 @@
  */
 
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/events.h"
 #include "common/file.h"
 #include "common/scummsys.h"
@@ -42,6 +43,7 @@
 namespace Pelrock {
 
 static const uint32 kInventoryArrowsOffset = 3186048; // ALFRED.7 — inventory scroll arrows
+static const uint32 kMemoryLogIntervalTicks = 30000 / kTickMs; // periodic memory report, about every 30s
 
 PelrockEngine *g_engine;
 
@@ -53,6 +55,8 @@ PelrockEngine::PelrockEngine(OSystem *syst, const ADGameDescription *gameDesc) :
 }
 
 PelrockEngine::~PelrockEngine() {
+	// The autosave writer still needs the engine for the save thumbnail
+	_autosaveWriter.flush();
 	delete _largeFont;
 	delete _smallFont;
 	delete _doubleSmallFont;
@@ -67,9 +71,11 @@ PelrockEngine::~PelrockEngine() {
 	delete _menu;
 	delete _graphics;
 	delete _state;
-	delete[] _alfredSprite;
+	_alfredHitMask.release();
 	delete[] _inventoryOverlayState.arrows[0];
 	delete[] _inventoryOverlayState.arrows[1];
+	free(_smokeState.frames);
+	freeCutsceneAssets();
 	// Free path-finding buffers (allocated via malloc in findPath)
 	if (_currentContext.pathBuffer) {
 		free(_currentContext.pathBuffer);
@@ -96,10 +102,20 @@ bool PelrockEngine::isScreenSaverDisabled() const {
 	return ConfMan.getBool("disable_screensaver");
 }
 
+void PelrockEngine::onReplayFinished() {
+	debug("Input replay finished after %u ticks", _chrono->getTickCount());
+	Common::String report = _perfStats.format();
+	debug("%s", report.c_str());
+	report = _sound->getStats().format();
+	debug("%s", report.c_str());
+	if (ConfMan.hasKey("replay_quit") && ConfMan.getBool("replay_quit"))
+		quitGame();
+}
+
 Common::Error PelrockEngine::run() {
 	// Initialize 320x200 paletted graphics mode
 	initGraphics(640, 400);
-	_screen = new Graphics::Screen();
+	_screen = new PelrockScreen();
 	_graphics = new GraphicsManager();
 	_room = new RoomManager();
 	_res = new ResourceManager();
@@ -120,6 +136,23 @@ Common::Error PelrockEngine::run() {
 	// Set the engine's debugger console
 	setDebugger(new PelrockConsole(this));
 
+	// Unattended playthroughs on build machines run the logic unthrottled
+	if (ConfMan.hasKey("fast_forward") && ConfMan.getBool("fast_forward")) {
+		_screen->setHeadless(ConfMan.hasKey("fast_forward_headless") && ConfMan.getBool("fast_forward_headless"));
+		_chrono->setFastForward(true);
+	}
+
+	// Input replays must start from a fresh launch so the seeds line up with the recording
+	if (ConfMan.hasKey("replay_input")) {
+		uint32 seed, ambientSeed;
+		if (_events->_recorder.startReplay(ConfMan.get("replay_input"), seed, ambientSeed)) {
+			_randomSource.setSeed(seed);
+			_sound->setAmbientSeed(ambientSeed);
+		}
+	} else if (ConfMan.hasKey("record_input")) {
+		_events->_recorder.startRecording(ConfMan.get("record_input"), _randomSource.getSeed(), _sound->getAmbientSeed());
+	}
+
 	_state->stateGame = shouldPlayIntro ? INTRO : GAME;
 
 	init();
@@ -230,20 +263,6 @@ Common::Array<VerbIcon> PelrockEngine::availableActions(HotSpot *hotspot) {
 
 Common::Point getPositionInBallonForIndex(int i);
 
-// Sort sprites by zOrder in-place
-void sortAnimsByZOrder(Common::Array<Sprite> &anims) {
-	for (size_t i = 0; i < anims.size(); ++i) {
-		Sprite key = anims[i];
-		int z = key.zOrder;
-		size_t j = i;
-		while (j > 0 && anims[j - 1].zOrder < z) {
-			anims[j] = anims[j - 1];
-			--j;
-		}
-		anims[j] = key;
-	}
-}
-
 void PelrockEngine::playSoundIfNeeded() {
 	if (_disableAmbientSounds)
 		return;
@@ -257,7 +276,7 @@ void PelrockEngine::playSoundIfNeeded() {
 			if (soundFileIndex != 0) { // 0 = NO_SOUND.SMP (disabled)
 				// Don't play the same sound twice at the same time
 				if (!_sound->isSoundIndexPlaying(soundFileIndex)) {
-					_sound->playSound(soundFileIndex);
+					_sound->playSound(soundFileIndex, -1, 1, kSoundAmbient);
 				}
 			}
 		}
@@ -269,57 +288,7 @@ void PelrockEngine::playSoundIfNeeded() {
  */
 void PelrockEngine::travelToEgypt() {
 	_state->setFlag(FLAG_TRAVEL_TO_EGYPT, true);
-	_graphics->fadeToBlack(10);
-
-	_sound->playMusicTrack(26, false);
-	byte *palette = new byte[768];
-	if (!_bgScreen.getPixels()) {
-		_bgScreen.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
-	}
-	_res->getExtraScreen(6, (byte *)_bgScreen.getPixels(), palette);
-	CursorMan.showMouse(false);
-	g_system->getPaletteManager()->setPalette(palette, 0, 256);
-
-	_screen->blitFrom(_bgScreen);
-	int frameCount = 0;
-	while (!shouldQuit() && frameCount < 96) {
-		_events->pollEvent();
-		g_system->delayMillis(10);
-		_chrono->updateChrono();
-		if (_chrono->_gameTick && _chrono->getFrameCount() % 2 == 0) {
-			int colorIndex = 160 + frameCount;
-			int index = colorIndex * 3;
-			palette[index] = 255;   // Red
-			palette[index + 1] = 0; // Green
-			palette[index + 2] = 0; // Blue
-			g_system->getPaletteManager()->setPalette(palette, 0, 256);
-			frameCount++;
-		}
-
-		_screen->markAllDirty();
-		_screen->update();
-	}
-	_graphics->clearScreen();
-
-	g_system->getPaletteManager()->setPalette(_room->_roomPalette, 0, 256);
-	_bgScreen.free();
-	CursorMan.showMouse(true);
-	delete[] palette;
-	_screen->markAllDirty();
-	_screen->update();
-
-	_alfredState.x = 575;
-	_alfredState.y = 210;
-	setScreenAndPrepare(21, ALFRED_DOWN);
-
-	// Original gives 4 items after room load (items 17, 64, 24, 59)
-	_state->inventoryItems.clear();
-	_state->selectedInventoryItem = -1;
-	// we dont want a flashing animation in this case! calling state->addInventory directly
-	_state->addInventoryItem(17);
-	_state->addInventoryItem(64);
-	_state->addInventoryItem(24);
-	_state->addInventoryItem(59);
+	startSequence(kSequenceTravelToEgypt);
 }
 
 /**
@@ -353,33 +322,41 @@ bool PelrockEngine::shouldSkipFrame() {
 	return false;
 }
 
-bool PelrockEngine::renderScene(int overlayMode) {
+int PelrockEngine::renderScene(int overlayMode) {
 
 	_chrono->updateChrono();
 	if (_chrono->_gameTick) {
-		if (shouldSkipFrame()) {
-			return false;
+		uint32 frameStart = g_system->getMillis();
+		_memStats.beginFrame();
+		// Ticks we fell behind on are stepped back to back; only the last one is presented
+		int stepped = 0;
+		do {
+			if (!shouldSkipFrame()) {
+				stepScene(overlayMode);
+				stepped++;
+				uint32 soundStarts, soundSteals;
+				uint activeChannels = _sound->sampleTick(soundStarts, soundSteals);
+				_perfStats.addAudio(_room->_currentRoomNumber, activeChannels, soundStarts, soundSteals);
+			}
+		} while (_chrono->consumeCatchUpTick());
+		if (_memStats.endFrame() > 0) {
+			debugC(1, kDebugMemory, "Allocations during frame %u in room %d: %s", _chrono->getTickCount(),
+				   _room->_currentRoomNumber, _memStats.formatFrame().c_str());
+		}
+		if (!stepped) {
+			return 0;
 		}
-
-		frameTriggers();
-
-		playSoundIfNeeded();
-
-		_graphics->copyBackgroundToBuffer();
-
-		_graphics->placeStickersFirstPass();
-
-		updateAnimations();
-
-		_graphics->placeStickersSecondPass();
-
-		renderOverlay(overlayMode);
-
-		mouseHoverForMap();
 
 		_graphics->presentFrame();
-
-		_graphics->updatePaletteAnimations();
+		// Effects that sequences start without waiting on them go over the presented frame
+		updateSmokeAnimation(stepped);
+		_dialog->updateSceneDialogue();
+		_perfStats.addFrame(_room->_currentRoomNumber, g_system->getMillis() - frameStart);
+		if (_chrono->getTickCount() >= _nextMemoryLogTick) {
+			_nextMemoryLogTick = _chrono->getTickCount() + kMemoryLogIntervalTicks;
+			if (debugChannelSet(2, kDebugMemory))
+				debugC(2, kDebugMemory, "Memory in room %d:\n%s", _room->_currentRoomNumber, _memStats.format().c_str());
+		}
 
 		// Execute deferred actions AFTER renderScene, so any scene changes
 		// (addSticker, disableSprite, etc.) are in place before the next frame's
@@ -389,7 +366,7 @@ bool PelrockEngine::renderScene(int overlayMode) {
 			doAction(_queuedAction.verb, &_room->_currentRoomHotspots[_queuedAction.hotspotIndex]);
 		}
 
-		return true;
+		return stepped;
 	}
 
 	switch (_room->_currentRoomNumber) {
@@ -408,7 +385,40 @@ bool PelrockEngine::renderScene(int overlayMode) {
 	}
 	}
 
-	return false;
+	return 0;
+}
+
+void PelrockEngine::stepScene(int overlayMode) {
+	if (_cutscene.extraScreen) {
+		// Only the cutscene that put the screen up runs; the room comes back once it is taken down
+		updateSequences();
+		if (_cutscene.extraScreen) {
+			drawExtraScreen();
+			return;
+		}
+	} else {
+		frameTriggers();
+
+		updateSequences();
+	}
+
+	playSoundIfNeeded();
+
+	_graphics->copyBackgroundToBuffer();
+
+	_graphics->placeStickersFirstPass();
+
+	updateAnimations();
+
+	_graphics->placeStickersSecondPass();
+
+	renderOverlay(overlayMode);
+
+	mouseHoverForMap();
+
+	_graphics->updatePaletteAnimations();
+
+	drawCutsceneOverlays();
 }
 
 void PelrockEngine::mouseHoverForMap() {
@@ -434,25 +444,8 @@ void PelrockEngine::maybeHaveDogPee() {
 	if (_room->_currentRoomNumber != 19) {
 		return;
 	}
-	Sprite *dog = _room->findSpriteByIndex(2);
-
-	if (_alfredState.x < 146 && !_isDogPeeing) {
-		_isDogPeeing = true;
-		dog->animData[0].nframes = 24;
-		while (!shouldQuit() && dog->animData[0].curFrame < 23) {
-			_events->pollEvent();
-			renderScene(OVERLAY_NONE);
-
-			_screen->update();
-			g_system->delayMillis(10);
-		}
-		dog->animData[0].nframes = 9;
-		dog->animData[0].curFrame = 0;
-
-		_dialog->say(_res->_ingameTexts[kTextQueAscoCasiMeMea]);
-		_currentHotspot = nullptr; // Clear so arrival direction isn't overridden by dog hotspot
-		walkTo(152, _alfredState.y);
-		_isDogPeeing = false;
+	if (_alfredState.x < 146 && !isSequenceRunning(kSequenceDogPee)) {
+		startSequence(kSequenceDogPee);
 	}
 }
 
@@ -648,26 +641,38 @@ static int calculateAlfredZOrder(int alfredY) {
 }
 
 void PelrockEngine::updateAnimations() {
-	// Sort sprites by zOrder (ascending: low z = back, rendered first)
-	sortAnimsByZOrder(_room->_currentRoomAnims);
+	// Draw order is by descending zOrder (high z = back, rendered first): disabled sprites (255),
+	// then the ones behind Alfred, then the ones in front of him.
+	const Common::Array<byte> &drawOrder = _room->getDrawOrder();
+	Common::Array<Sprite> &anims = _room->_currentRoomAnims;
 
 	int alfredZOrder = calculateAlfredZOrder(_alfredState.y);
 
+	uint first = 0;
+	while (first < drawOrder.size() && anims[drawOrder[first]].zOrder == 255) {
+		first++;
+	}
+	uint split = first;
+	while (split < drawOrder.size() && anims[drawOrder[split]].zOrder > alfredZOrder) {
+		split++;
+	}
+
 	// First pass: sprites behind Alfred (sprite zOrder > alfredZOrder)
-	for (uint i = 0; i < _room->_currentRoomAnims.size(); i++) {
-		if (_room->_currentRoomAnims[i].zOrder > alfredZOrder || _room->_currentRoomAnims[i].zOrder == 255) {
-			drawNextFrame(&_room->_currentRoomAnims[i]);
-		}
+	for (uint i = first; i < split; i++) {
+		drawNextFrame(&anims[drawOrder[i]]);
 	}
 
 	// Draw Alfred
 	chooseAlfredStateAndDraw();
 
 	// Second pass: sprites in front of Alfred (sprite zOrder <= alfredZOrder)
-	for (uint i = 0; i < _room->_currentRoomAnims.size(); i++) {
-		if (_room->_currentRoomAnims[i].zOrder <= alfredZOrder && _room->_currentRoomAnims[i].zOrder != 255) {
-			drawNextFrame(&_room->_currentRoomAnims[i]);
-		}
+	for (uint i = split; i < drawOrder.size(); i++) {
+		drawNextFrame(&anims[drawOrder[i]]);
+	}
+
+	// Decor animations and idle sprites leave the hover result alone
+	if (updateSpriteHitKeys()) {
+		_spriteFrameEpoch++;
 	}
 
 	if (_actionPopupState.isActive) {
@@ -839,6 +844,7 @@ void PelrockEngine::chooseAlfredStateAndDraw() {
 					_alfredState.y = exit->targetY;
 					setScreenAndPrepare(exit->targetRoom, exit->dir);
 					_graphics->placeStickersFirstPass();
+					takeSnapshot();
 				}
 			}
 		} else {
@@ -898,13 +904,10 @@ void PelrockEngine::chooseAlfredStateAndDraw() {
 		break;
 	}
 	case ALFRED_SPECIAL_ANIM: {
-		byte *frame = new byte[_res->_currentSpecialAnim->stride * _res->_currentSpecialAnim->numFrames];
-		extractSingleFrame(_res->_currentSpecialAnim->animData,
-						   frame,
-						   _res->_currentSpecialAnim->curFrame,
-						   _res->_currentSpecialAnim->w,
-						   _res->_currentSpecialAnim->h);
+		byte *frame = _res->_currentSpecialAnim->frameView(_res->_currentSpecialAnim->curFrame);
 		if (_res->_currentSpecialAnim->w == kAlfredFrameWidth && _res->_currentSpecialAnim->h == kAlfredFrameHeight) {
+			// Every special anim decodes into the same pool, so the address does not identify the frame
+			_alfredHitMaskFrame = nullptr;
 			drawAlfred(frame);
 		} else {
 			// Scale special anim frame to Alfred size before drawing
@@ -925,7 +928,6 @@ void PelrockEngine::chooseAlfredStateAndDraw() {
 			}
 		}
 
-		delete[] frame;
 		break;
 	}
 	}
@@ -994,9 +996,14 @@ void PelrockEngine::drawAlfred(byte *buf) {
 		finalWidth = 1;
 	}
 
-	byte *scaledBuf = _graphics->scale(scaleCalc.scaleY, finalWidth, finalHeight, buf);
-	delete[] _alfredSprite;
-	_alfredSprite = scaledBuf;
+	_graphics->scale(scaleCalc.scaleY, finalWidth, finalHeight, buf, _alfredSprite);
+
+	// The mask only depends on the source frame and the scale, so most ticks (idle, standing still) reuse it
+	if (buf != _alfredHitMaskFrame || scaleCalc.scaleY != _alfredHitMaskScale) {
+		_alfredHitMask.build(_alfredSprite, finalWidth, finalHeight);
+		_alfredHitMaskFrame = buf;
+		_alfredHitMaskScale = scaleCalc.scaleY;
+	}
 
 	// Shadow detection: scan across Alfred's width at feet line.
 	// The shadow map value (0-3) indexes into the palette remap tables.
@@ -1128,6 +1135,29 @@ void PelrockEngine::drawNextFrame(Sprite *sprite) {
 	}
 }
 
+bool PelrockEngine::updateSpriteHitKeys() {
+	const Common::Array<Sprite> &anims = _room->_currentRoomAnims;
+	bool changed = _spriteHitKeys.size() != anims.size();
+	_spriteHitKeys.resize(anims.size());
+	for (uint i = 0; i < anims.size(); i++) {
+		// Sprites come first in the unified hotspot list; a disabled hotspot is never hit tested
+		uint64 key = 0;
+		const Sprite &sprite = anims[i];
+		if (i < _room->_currentRoomHotspots.size() && _room->_currentRoomHotspots[i].isEnabled) {
+			const Anim &anim = sprite.animData[sprite.curAnimIndex];
+			key = ((uint64)(uint16)sprite.x << 48) | ((uint64)(uint16)sprite.y << 32) |
+				  ((uint64)(sprite.curAnimIndex & 0xFF) << 24) | ((uint64)(anim.curFrame & 0x7FFF) << 8) | sprite.zOrder;
+			// Never 0, so a sprite whose hotspot gets enabled counts as a change
+			key |= (uint64)1 << 23;
+		}
+		if (_spriteHitKeys[i] != key) {
+			_spriteHitKeys[i] = key;
+			changed = true;
+		}
+	}
+	return changed;
+}
+
 void PelrockEngine::paintDebugLayer() {
 	bool showWalkboxes = true;
 
@@ -1204,28 +1234,18 @@ void PelrockEngine::checkLongMouseClick(int x, int y) {
 }
 
 int PelrockEngine::isHotspotUnder(int x, int y) {
-
-	for (size_t i = 0; i < _room->_currentRoomHotspots.size(); i++) {
-		HotSpot hotspot = _room->_currentRoomHotspots[i];
+	const Common::Array<byte> &candidates = _room->getHitIndex().hotspotsAt(x, y);
+	for (uint c = 0; c < candidates.size(); c++) {
+		int i = candidates[c];
+		const HotSpot &hotspot = _room->_currentRoomHotspots[i];
 		if (hotspot.isEnabled &&
 			x >= hotspot.x && x <= (hotspot.x + hotspot.w) &&
 			y >= hotspot.y && y <= (hotspot.y + hotspot.h)) {
 			// Check against sprite frame
 			if (!hotspot.isSprite) {
 				return hotspot.index;
-			} else {
-				Sprite *sprite = nullptr;
-				for (size_t j = 0; j < _room->_currentRoomAnims.size(); j++) {
-					if (_room->_currentRoomAnims[j].index == hotspot.index) {
-						sprite = &(_room->_currentRoomAnims[j]);
-						break;
-					}
-				}
-				bool spriteUnder = isSpriteUnder(sprite, x, y);
-				if (spriteUnder)
-					return i;
-				else
-					continue;
+			} else if (isSpriteUnder(_room->findSpriteByIndex(hotspot.index), x, y)) {
+				return i;
 			}
 		}
 	}
@@ -1233,12 +1253,13 @@ int PelrockEngine::isHotspotUnder(int x, int y) {
 }
 
 Exit *PelrockEngine::isExitUnder(int x, int y) {
-	for (uint i = 0; i < _room->_currentRoomExits.size(); i++) {
-		Exit exit = _room->_currentRoomExits[i];
+	const Common::Array<byte> &candidates = _room->getHitIndex().exitsAt(x, y);
+	for (uint c = 0; c < candidates.size(); c++) {
+		Exit &exit = _room->_currentRoomExits[candidates[c]];
 		// Original game uses: x <= exit.x + exit.w - 1 and y <= exit.y + exit.h - 1
 		if (x >= exit.x && x <= (exit.x + exit.w - 1) &&
 			y >= exit.y && y <= (exit.y + exit.h - 1) && exit.isEnabled) {
-			return &(_room->_currentRoomExits[i]);
+			return &exit;
 		}
 	}
 	return nullptr;
@@ -1251,18 +1272,17 @@ bool PelrockEngine::isSpriteUnder(Sprite *sprite, int x, int y) {
 	if (sprite == nullptr) {
 		return false;
 	}
-	Anim &animData = sprite->animData[sprite->curAnimIndex];
-	int curFrame = animData.curFrame;
-
 	int localX = x - sprite->x;
 	int localY = y - sprite->y;
-	if (localX >= 0 && localX < sprite->w && localY >= 0 && localY < sprite->h) {
-		byte pixel = animData.animData[curFrame][localY * sprite->w + localX];
-		if (pixel != 255) {
-			return true;
-		}
+	if (localX < 0 || localX >= sprite->w || localY < 0 || localY >= sprite->h) {
+		return false;
 	}
-	return false;
+
+	Anim &animData = sprite->animData[sprite->curAnimIndex];
+	if (animData.curFrame >= animData.numHitMasks) {
+		return false;
+	}
+	return animData.hitMasks[animData.curFrame].test(localX, localY);
 }
 
 Common::Point getPositionInBalloonForIndex(int i, int x, int y) {
@@ -1468,9 +1488,34 @@ int PelrockEngine::checkMouseClickInventoryOverlay(int x, int y) {
 
 void PelrockEngine::gameLoop() {
 	_events->pollEvent();
-	checkMouse();
+	// Clicks go to a line the scene is showing
+	if (!isInputBlockedBySequence() && !_dialog->isSceneDialogueActive()) {
+		checkSnapshotKeys();
+		checkMouse();
+	}
 	renderScene();
 	_screen->update();
+	_chrono->waitForNextTick();
+}
+
+void PelrockEngine::checkSnapshotKeys() {
+	if (!(_events->_lastKeyFlags & Common::KBD_CTRL))
+		return;
+	switch (_events->_lastKeyEvent) {
+	case Common::KEYCODE_s:
+		if (takeSnapshot())
+			debug("Snapshot %u taken in room %d", _snapshots.get(0).id, _room->_currentRoomNumber);
+		break;
+	case Common::KEYCODE_l:
+		restoreSnapshot(0);
+		break;
+	case Common::KEYCODE_r:
+		rewindSnapshot();
+		break;
+	default:
+		return;
+	}
+	_events->_lastKeyEvent = Common::KEYCODE_INVALID;
 }
 
 void PelrockEngine::computerLoop() {
@@ -1492,7 +1537,7 @@ void PelrockEngine::extraScreenLoop() {
 			_events->_leftMouseClicked = false;
 			break;
 		}
-		g_system->delayMillis(10);
+		_chrono->idle();
 		_screen->markAllDirty();
 		_screen->update();
 	}
@@ -1506,10 +1551,7 @@ void PelrockEngine::walkLoop(int16 x, int16 y, AlfredDirection direction) {
 	_alfredState.direction = direction;
 	walkTo(x, y);
 	while (!shouldQuit() && _alfredState.animState == ALFRED_WALKING) {
-		_events->pollEvent();
-		renderScene();
-		_screen->update();
-		g_system->delayMillis(10);
+		pumpFrame();
 	}
 }
 
@@ -1520,13 +1562,20 @@ void PelrockEngine::walkTo(int x, int y) {
 }
 
 void PelrockEngine::walkAndAction(HotSpot *hotspot, VerbIcon action) {
+	if (hotspot == nullptr) {
+		return;
+	}
+	startWalkAndAction(hotspot, action);
+	waitForActionEnd();
+}
+
+void PelrockEngine::startWalkAndAction(HotSpot *hotspot, VerbIcon action) {
 	if (hotspot == nullptr) {
 		return;
 	}
 	_disableAction = true;
 	walkTo(hotspot->x + hotspot->w / 2, hotspot->y + hotspot->h);
 	_queuedAction = QueuedAction{action, hotspot->index, true, false};
-	waitForActionEnd();
 }
 
 AlfredDirection PelrockEngine::calculateAlfredsDirection(HotSpot *hotspot) {
@@ -1596,13 +1645,10 @@ VerbIcon PelrockEngine::isActionUnder(int x, int y) {
 bool PelrockEngine::isAlfredUnder(int x, int y) {
 	int localX = x - _alfredState.x;
 	int localY = y - _alfredState.y + _alfredState.h; // Adjust for scaling (since Alfred's position is based on his feet, but sprite may be scaled from the top)
-	if (_alfredSprite != nullptr && localX >= 0 && localX < _alfredState.w && localY >= 0 && localY < _alfredState.h) {
-		byte pixel = _alfredSprite[localY * _alfredState.w + localX];
-		if (pixel != 255) {
-			return true;
-		}
+	if (localX < 0 || localX >= _alfredState.w || localY < 0 || localY >= _alfredState.h) {
+		return false;
 	}
-	return false;
+	return _alfredHitMask.test(localX, localY);
 }
 
 void PelrockEngine::checkMouseClick(int x, int y) {
@@ -1625,6 +1671,10 @@ void PelrockEngine::checkMouseClick(int x, int y) {
 }
 
 void PelrockEngine::changeCursor(Cursor cursor) {
+	if (_activeCursor == cursor) {
+		return;
+	}
+	_activeCursor = cursor;
 	CursorMan.replaceCursor(_res->_cursorMasks[cursor], kCursorWidth, kCursorHeight, 0, 0, 255);
 }
 
@@ -1633,21 +1683,45 @@ void PelrockEngine::checkMouseHover() {
 		return;
 	}
 
+	// Nothing under the cursor can change unless the mouse moved, the room was mutated, a reachable
+	// sprite changed or Alfred moved or changed frame
+	uint32 roomEpoch = _room->getMutationEpoch();
+	if (_hoverCache.matches(_events->_mouseX, _events->_mouseY, roomEpoch, _spriteFrameEpoch,
+							_alfredState.x, _alfredState.y, _alfredHitMaskFrame, _alfredHitMaskScale)) {
+		_hoverCache.hits++;
+		if (_hoverCache.cursor != -1)
+			changeCursor((Cursor)_hoverCache.cursor);
+		return;
+	}
+	_hoverCache.misses++;
+	_hoverCache.isValid = true;
+	_hoverCache.mouseX = _events->_mouseX;
+	_hoverCache.mouseY = _events->_mouseY;
+	_hoverCache.roomEpoch = roomEpoch;
+	_hoverCache.frameEpoch = _spriteFrameEpoch;
+	_hoverCache.alfredX = _alfredState.x;
+	_hoverCache.alfredY = _alfredState.y;
+	_hoverCache.alfredFrame = _alfredHitMaskFrame;
+	_hoverCache.alfredScale = _alfredHitMaskScale;
+	_hoverCache.cursor = -1;
+
 	bool hotspotDetected = false;
 	int hotspotIndex = isHotspotUnder(_events->_mouseX, _events->_mouseY);
 
-	bool alfredDetected = false;
-	if (isAlfredUnder(_events->_mouseX, _events->_mouseY)) {
-		alfredDetected = true;
-		_hoveredMapLocation = "Alfred";
-	}
+	bool alfredDetected = isAlfredUnder(_events->_mouseX, _events->_mouseY);
 
+	const char *location = nullptr;
 	if (hotspotIndex != -1) {
 		hotspotDetected = true;
 		if (hotspotIndex < (int)_room->_currentRoomDescriptions.size())
-			_hoveredMapLocation = _room->_currentRoomDescriptions[hotspotIndex].text;
-	} else if (!alfredDetected) {
-		_hoveredMapLocation = "";
+			location = _room->_currentRoomDescriptions[hotspotIndex].text.c_str();
+		else if (alfredDetected)
+			location = "Alfred";
+	} else {
+		location = alfredDetected ? "Alfred" : "";
+	}
+	if (location != nullptr && _hoveredMapLocation != location) {
+		_hoveredMapLocation = location;
 	}
 
 	if (_room->_currentRoomNumber == 21) {
@@ -1664,20 +1738,24 @@ void PelrockEngine::checkMouseHover() {
 		exitDetected = true;
 	}
 
+	Cursor cursor;
 	if (hotspotDetected && exitDetected) {
-		changeCursor(COMBINATION);
+		cursor = COMBINATION;
 	} else if (hotspotDetected) {
-		changeCursor(HOTSPOT);
+		cursor = HOTSPOT;
 	} else if (exitDetected) {
-		changeCursor(EXIT);
+		cursor = EXIT;
 	} else if (alfredDetected) {
-		changeCursor(ALFRED);
+		cursor = ALFRED;
 	} else {
-		changeCursor(DEFAULT);
+		cursor = DEFAULT;
 	}
+	_hoverCache.cursor = cursor;
+	changeCursor(cursor);
 }
 
-void PelrockEngine::setScreen(int roomNumber) {
+void PelrockEngine::setScreen(int roomNumber, bool reuseAssets) {
+	uint32 loadStart = g_system->getMillis();
 	Common::File roomFile;
 	if (!roomFile.open(Common::Path("ALFRED.1"))) {
 		error("Could not open ALFRED.1");
@@ -1685,6 +1763,9 @@ void PelrockEngine::setScreen(int roomNumber) {
 	}
 	changeCursor(DEFAULT);
 	_sound->stopAllSounds();
+	stopSequences();
+	_dialog->stopSceneDialogue();
+	stopSmokeAnimation();
 	_currentHotspot = nullptr;
 	_currentStep = 0;
 	int roomOffset = roomNumber * kRoomStructSize;
@@ -1693,32 +1774,40 @@ void PelrockEngine::setScreen(int roomNumber) {
 	byte *palette = new byte[256 * 3];
 	_room->getPalette(&roomFile, roomOffset, palette);
 	memcpy(_room->_roomPalette, palette, 768);
-	_currentBackground.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
-	_room->getBackground(&roomFile, roomOffset, (byte *)_currentBackground.getPixels());
+	reuseAssets = reuseAssets && _room->isRoomLoaded(roomNumber) && !_backgroundModified;
+	if (!reuseAssets) {
+		_currentBackground.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
+		_room->getBackground(&roomFile, roomOffset, (byte *)_currentBackground.getPixels());
+		_backgroundModified = false;
+	}
 
 	_screen->clear();
 
 	_graphics->copyBackgroundToBuffer();
 	g_system->getPaletteManager()->setPalette(palette, 0, 256);
 
-	_room->loadRoomMetadata(&roomFile, roomNumber);
+	_room->loadRoomMetadata(&roomFile, roomNumber, reuseAssets);
 
 	roomFile.close();
 	delete[] palette;
+	_perfStats.addLoad(roomNumber, g_system->getMillis() - loadStart);
 }
 
-void PelrockEngine::setScreenAndPrepare(int roomNumber, AlfredDirection dir) {
-	setScreen(roomNumber);
+void PelrockEngine::setScreenAndPrepare(int roomNumber, AlfredDirection dir, bool reuseAssets) {
+	// Decided before setScreen, which makes roomNumber the loaded room either way
+	bool keepTalkingAnims = reuseAssets && _room->isRoomLoaded(roomNumber) && _room->_talkingAnims.animA != nullptr;
+	setScreen(roomNumber, reuseAssets);
 	_alfredState.direction = dir;
 	_alfredState.setState(ALFRED_IDLE);
-	_room->loadRoomTalkingAnimations(roomNumber);
+	if (!keepTalkingAnims)
+		_room->loadRoomTalkingAnimations(roomNumber);
 	if (_room->_musicTrack > 0)
 		_sound->playMusicTrack(_room->_musicTrack);
 	else {
 		_sound->stopMusic();
 	}
 
-	if (findWalkboxForPoint(_room->_currentRoomWalkboxes, _alfredState.x, _alfredState.y) == 0xFF) {
+	if (_room->findWalkboxAt(_alfredState.x, _alfredState.y) == 0xFF) {
 		const WalkBox w = _room->_currentRoomWalkboxes[0];
 		_alfredState.x = w.x;
 		_alfredState.y = w.y;
@@ -1744,12 +1833,24 @@ void PelrockEngine::loadExtraScreenAndPresent(int screenIndex) {
 	_screen->update();
 }
 
+int PelrockEngine::pumpFrame(int overlayMode) {
+	_events->pollEvent();
+	int ticks = renderScene(overlayMode);
+	_screen->update();
+	_chrono->waitForNextTick();
+	return ticks;
+}
+
+void PelrockEngine::waitTicks(int ticks, int overlayMode) {
+	int ticksDone = 0;
+	while (!shouldQuit() && ticksDone < ticks) {
+		ticksDone += pumpFrame(overlayMode);
+	}
+}
+
 void PelrockEngine::waitForSpecialAnimation() {
 	while (!g_engine->shouldQuit() && !_res->_isSpecialAnimFinished) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_screen->update();
-		g_system->delayMillis(10);
+		pumpFrame();
 	}
 }
 
@@ -1795,10 +1896,7 @@ void PelrockEngine::doExtraActions(int roomNumber) {
 			pigeons->disableAfterSequence = true;
 			pigeons->animData[0].curFrame = 0;
 			while (!g_engine->shouldQuit() && pigeons->zOrder != 255) {
-				_events->pollEvent();
-				renderScene();
-				_screen->update();
-				g_system->delayMillis(10);
+				pumpFrame();
 			}
 			_dialog->say(_res->_ingameTexts[kTextPracticarMas]);
 			_state->setFlag(FLAG_PIGEON_DEAD, true);
@@ -1919,16 +2017,7 @@ void PelrockEngine::doExtraActions(int roomNumber) {
 			walkAndAction(_room->findHotspotByExtra(634), TALK);
 			_room->addSticker(134);
 			// wait a few frames
-			int framesToWait = 0;
-			while (!shouldQuit() && framesToWait < 10) {
-				_events->pollEvent();
-
-				bool didRender = renderScene(OVERLAY_NONE);
-				if (didRender)
-					framesToWait++;
-				_screen->update();
-				g_system->delayMillis(10);
-			}
+			waitTicks(10);
 			_alfredState.x = 294;
 			_alfredState.y = 387;
 			_room->addSticker(136);
@@ -1974,335 +2063,11 @@ void PelrockEngine::doExtraActions(int roomNumber) {
 }
 
 void PelrockEngine::pyramidCollapse() {
-
-	// Hide NPC initially
-	Sprite *npc = _room->findSpriteByIndex(0);
-	if (npc)
-		npc->zOrder = 255;
-
-	// Start collapse animation
-	Sprite *collapseSprite = _room->findSpriteByIndex(2);
-	if (collapseSprite)
-		collapseSprite->zOrder = 254;
-
-	// Play collapse sound
-	_sound->playSound("QUAKE1ZZ.SMP", 0);
-
-	// Wait for collapse animation frame 5
-	while (!shouldQuit()) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_screen->update();
-		g_system->delayMillis(10);
-		collapseSprite = _room->findSpriteByIndex(2);
-		if (!collapseSprite || collapseSprite->animData[collapseSprite->curAnimIndex].curFrame >= 5) {
-			collapseSprite->zOrder = 255; // Hide collapse animation sprite
-			break;
-		}
-	}
-
-	// Background tile copies to have collapsed pyramid stick
-	// copy 99×45 from secondary buffer to front buffer
-	{
-		static const int srcX = 240, srcY = 145;
-		static const int copyW = 99, copyH = 45;
-		Common::Rect copyRect(srcX, srcY, srcX + copyW, srcY + copyH);
-		_currentBackground.blitFrom(_compositeBuffer, copyRect, Common::Point(srcX, srcY));
-	}
-	_room->findSpriteByIndex(2)->zOrder = 255;
-
-	_dialog->say(_res->_ingameTexts[kTextYaNoSeHaceOnComoAntes]);
-	npc = _room->findSpriteByIndex(0);
-	if (npc)
-		npc->zOrder = 254;
-
-	npc = _room->findSpriteByIndex(0);
-	npc->animData[0].nframes = 5;
-	if (npc) {
-		npc->animData[npc->curAnimIndex].movementFlags = 0x1C;
-		npc->y -= 25; // One-time nudge upward to emerge from behind pyramid
-	}
-	while (!shouldQuit()) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_screen->update();
-		g_system->delayMillis(10);
-		npc = _room->findSpriteByIndex(0);
-		if (!npc || npc->x >= 339)
-			break;
-	}
-
-	npc = _room->findSpriteByIndex(0);
-	if (npc)
-		npc->animData[npc->curAnimIndex].movementFlags = 0x340;
-	while (!shouldQuit()) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_screen->update();
-		g_system->delayMillis(10);
-		npc = _room->findSpriteByIndex(0);
-		if (!npc || npc->y >= 206)
-			break;
-	}
-
-	npc = _room->findSpriteByIndex(0);
-	if (npc)
-		npc->animData[npc->curAnimIndex].movementFlags = 0x14;
-	while (!shouldQuit()) {
-		_events->pollEvent();
-		renderScene(OVERLAY_NONE);
-		_screen->update();
-		g_system->delayMillis(10);
-		npc = _room->findSpriteByIndex(0);
-		if (!npc || npc->x <= 307)
-			break;
-	}
-
-	// Stop NPC movement
-	npc = _room->findSpriteByIndex(0);
-	npc->animData[0].nframes = 1;
-	if (npc)
-		npc->animData[npc->curAnimIndex].movementFlags = 0;
-
-	_dialog->say(_res->_ingameTexts[kTextPor5Minutos], 0);
-
-	_room->disableExit(36, 0);
-
-	_room->addStickerToRoom(21, 79);
-	_room->disableExit(21, 2, PERSIST_BOTH);
-	HotSpot *pyramidHotspot = new HotSpot();
-	pyramidHotspot->x = 510;
-	pyramidHotspot->y = 33;
-	pyramidHotspot->w = 99;
-	pyramidHotspot->h = 45;
-	pyramidHotspot->extra = 411;
-	pyramidHotspot->isEnabled = false;
-	pyramidHotspot->innerIndex = 2;
-	pyramidHotspot->index = 7;
-	_room->disableHotspot(21, pyramidHotspot, PERSIST_BOTH);
-
-	_dialog->say(_res->_ingameTexts[kTextTaLuegoLucas]);
-
-	// Walk Alfred to right edge exit -> room 21
-	walkLoop(603, 212, ALFRED_RIGHT);
+	startSequence(kSequencePyramidCollapse);
 }
 
 void PelrockEngine::endingScene() {
-	byte *palette = new byte[768];
-	if (!_bgScreen.getPixels()) {
-		_bgScreen.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
-	}
-	_res->getExtraScreen(14, (byte *)_bgScreen.getPixels(), palette);
-	CursorMan.showMouse(false);
-	_graphics->clearScreen();
-	g_system->getPaletteManager()->setPalette(palette, 0, 256);
-	Common::File alfred7;
-	if (!alfred7.open(Common::Path("ALFRED.7"))) {
-		error("Could not open ALFRED.7");
-		return;
-	}
-	byte *decompressedBuf = nullptr;
-	size_t decompressedSize = 0;
-	rleDecompressSingleBuda(&alfred7, 3222250, decompressedBuf, decompressedSize);
-	alfred7.close();
-
-	int animValues[4][8] = {
-		{426, 211, 114, 189, 2, 2, 0, 0}, // Legs anim values (2 frames)
-		{287, 68, 42, 26, 3, 1, 1, 15},   // Eyes anim values (3 frames)
-		{172, 173, 93, 71, 3, 1, 3, 17},  // Alfred hand anim values (3 frames)
-		{241, 334, 55, 66, 2, 2, 0, 0}    // Hand anim values (2 frames)
-	};
-
-	uint32 pos = 0;
-	Common::Array<Sprite *> sprites;
-	for (int i = 0; i < 4; i++) {
-		Sprite *sprite = new Sprite();
-		sprite->x = animValues[i][0];
-		sprite->y = animValues[i][1];
-		sprite->w = animValues[i][2];
-		sprite->h = animValues[i][3];
-		sprite->stride = animValues[i][2] * animValues[i][3];
-		bool isIdleAnim = animValues[i][7] > 0;
-		if (isIdleAnim) {
-			sprite->numAnims = 2;
-		} else {
-			sprite->numAnims = 1;
-		}
-
-		sprite->animData = new Anim[sprite->numAnims];
-		Anim mainAnim;
-		mainAnim.nframes = animValues[i][4];
-		mainAnim.loopCount = animValues[i][6];
-		mainAnim.speed = animValues[i][5];
-
-		byte *legsAnimData = new byte[sprite->stride * mainAnim.nframes];
-		Common::copy(decompressedBuf + pos, decompressedBuf + pos + sprite->stride * mainAnim.nframes, legsAnimData);
-		mainAnim.animData = new byte *[mainAnim.nframes];
-		for (int j = 0; j < mainAnim.nframes; j++) {
-			mainAnim.animData[j] = new byte[sprite->stride];
-			extractSingleFrame(legsAnimData, mainAnim.animData[j], j, sprite->w, sprite->h);
-		}
-
-		if (isIdleAnim) {
-			Anim idleAnim;
-			idleAnim.nframes = 1;
-			idleAnim.loopCount = 1;
-			idleAnim.speed = animValues[i][7];
-			idleAnim.animData = new byte *[1];
-			idleAnim.animData[0] = new byte[sprite->stride];
-			extractSingleFrame(legsAnimData, idleAnim.animData[0], 0, sprite->w, sprite->h);
-			sprite->animData[0] = idleAnim;
-			sprite->animData[1] = mainAnim;
-		} else {
-			sprite->animData[0] = mainAnim;
-		}
-
-		pos += sprite->stride * mainAnim.nframes;
-		delete[] legsAnimData;
-		sprites.push_back(sprite);
-	}
-
-	Common::Rect bbox1 = _largeFont->getBoundingBox("ALFRED PELROCK");
-	int y1 = 400 / 2 - bbox1.height() / 2;
-	int y2 = 400 / 2 + bbox1.height() / 2;
-	int ticks = 0;
-	_sound->playMusicTrack(3);
-	// Loop runs indefinitely — original game waits for any keypress before advancing to credits.
-	_events->_lastKeyEvent = Common::KEYCODE_INVALID;
-	while (!shouldQuit()) {
-		_events->pollEvent();
-
-		_chrono->updateChrono();
-
-		if (_chrono->_gameTick) {
-			_compositeBuffer.blitFrom(_bgScreen);
-
-			for (Sprite *sprite : sprites) {
-				drawNextFrame(sprite);
-			}
-
-			_screen->blitFrom(_compositeBuffer);
-			// Title text visible frames 21–149 (original: frame > 0x14 && frame < 0x96)
-			if (ticks > 20 && ticks < 150) {
-				drawText(_largeFont, "ALFRED PELROCK", 0, y1, 640, 255);
-				drawText(_largeFont, "En busca de un sue\x80o", 0, y2, 640, 255);
-			}
-			ticks++;
-		}
-
-		// Any keypress advances to credits (original: infinite loop until input)
-		if (_events->_lastKeyEvent != Common::KEYCODE_INVALID) {
-			_events->_lastKeyEvent = Common::KEYCODE_INVALID;
-			break;
-		}
-
-		g_system->delayMillis(10);
-		_screen->markAllDirty();
-		_screen->update();
-	}
-
-	_screen->clear(0);
-	g_system->getPaletteManager()->setPalette(_room->_roomPalette, 0, 256);
-	_bgScreen.free();
-
-	CursorMan.showMouse(true);
-	delete[] palette;
-	_screen->markAllDirty();
-	_screen->update();
-	if (shouldQuit())
-		return;
-	credits();
-}
-
-void PelrockEngine::credits() {
-	_sound->playMusicTrack(3);
-	// 25-page room slideshow: each page loads a game room and overlays credit texts.
-	static const int kNumCreditPages = 25;
-	static const int kCreditRooms[kNumCreditPages] = {
-		22, 27, 36, 23, 24, 37, 25, 26, 49, 43, 35, 52, 29,
-		39, 40, 41, 45, 47, 21, 50, 46, 42, 34, 30, 14};
-	static const int kFramesPerPage = 45;
-
-	Common::Array<Common::StringArray> creditTexts = _res->getCredits();
-	Common::Array<int> creditsSpeakerId;
-	// Preprocess credit texts: extract speaker IDs and apply word wrapping
-	for (uint i = 0; i < creditTexts.size(); i++) {
-		byte speakerId;
-		_dialog->processColorAndTrim(creditTexts[i], speakerId);
-		creditsSpeakerId.push_back(speakerId);
-		// Text is already encoded for new lines but should also be wrapped to respect the max chars per line!
-		creditTexts[i] = _dialog->wordWrap(creditTexts[i])[0];
-		// all lines start with a space but the first one contains the trailing space of the speakerId
-		creditTexts[i][0] = creditTexts[i][0].substr(1, creditTexts[i][0].size() - 1);
-	}
-
-	CursorMan.showMouse(false);
-
-	// Outer restart loop — keypress during display restarts from page 0
-
-	_alfredState.setState(ALFRED_SKIP_DRAWING);
-	_disableAmbientSounds = true;
-	_disableAction = true;
-	bool keyPressed = false;
-	do {
-		for (int page = 0; page < kNumCreditPages && !shouldQuit(); page++) {
-			// loads screen
-			setScreen(kCreditRooms[page]);
-			if (kCreditRooms[page] == 24) {
-				Sprite *pigeons = _room->findSpriteByIndex(1);
-				pigeons->disableAfterSequence = true;
-			}
-
-			int height = creditTexts[page].size() * 25; // Add some padding
-
-			Graphics::Surface s;
-			s.create(640, height + 1, Graphics::PixelFormat::createFormatCLUT8());
-			s.fillRect(s.getRect(), 255); // Clear surface
-
-			int maxWidth = 0;
-			/**
-			 * Last line is less indented for some reason, so skip that for calculation
-			 */
-			for (uint i = 0; i < creditTexts[page].size(); i++) {
-				maxWidth = MAX(maxWidth, g_engine->_largeFont->getStringWidth(creditTexts[page][i]));
-			}
-
-			int startX = 320 - (maxWidth / 2);
-			int startY = (400 - s.getRect().height()) / 2 - 10;
-
-			for (uint i = 0; i < creditTexts[page].size(); i++) {
-				// subtract that extra negative identation
-				int xPos = i == creditTexts[page].size() - 1 ? startX - 10 : startX;
-				int yPos = i * 25; // Above sprite, adjust for line
-				g_engine->_largeFont->drawString(&s, creditTexts[page][i], xPos, yPos, 640, creditsSpeakerId[page], Graphics::kTextAlignLeft);
-			}
-
-			int frames = 0;
-			_events->_lastKeyEvent = Common::KEYCODE_INVALID;
-			while (!shouldQuit() && frames < kFramesPerPage) {
-				_events->pollEvent();
-				bool didRender = renderScene(OVERLAY_NONE);
-
-				if (didRender) {
-					_screen->transBlitFrom(s, s.getRect(), Common::Point(0, startY), 255);
-					frames++;
-				}
-				_screen->markAllDirty();
-				_screen->update();
-				g_system->delayMillis(10);
-				if (_events->_lastKeyEvent != Common::KEYCODE_INVALID) {
-					// Any key press exits credits
-					keyPressed = true;
-					break;
-				}
-			}
-			if (keyPressed) {
-				break;
-			}
-		}
-	} while (!shouldQuit() && !keyPressed);
-
-	g_engine->quitGame();
+	startSequence(kSequenceEnding);
 }
 
 void PelrockEngine::initGodsSequences(int roomNumber) {
@@ -2310,9 +2075,6 @@ void PelrockEngine::initGodsSequences(int roomNumber) {
 	_fightFrameCounter = 0;
 	_fightSorcererSpriteIdx = kFightRooms[idx].spriteIdx;
 	_fightSorcererAppeared = false;
-	_fightSpellCast = false;
-	_fightSpellFrameCounter = 0;
-	_fightInBlockingAnim = false;
 
 	_room->disableSprite(_fightSorcererSpriteIdx);
 }
@@ -2328,8 +2090,7 @@ void PelrockEngine::handleFightRoomFrame() {
 		return;
 	}
 
-	// Guard against reentrance from blocking animation loops calling renderScene
-	if (_fightInBlockingAnim)
+	if (isSequenceRunning(kSequenceSorcererAppears) || isSequenceRunning(kSequenceSorcererSpell))
 		return;
 
 	if (_alfredState.animState != ALFRED_IDLE || _actionPopupState.isActive) {
@@ -2339,49 +2100,14 @@ void PelrockEngine::handleFightRoomFrame() {
 
 	// Phase 1: NPC appearance at tick 64
 	if (!_fightSorcererAppeared && _fightFrameCounter >= 64) {
-		_sound->playSound(_room->_roomSfx[0]);
 		_fightSorcererAppeared = true;
-		_fightInBlockingAnim = true;
-		_room->findSpriteByIndex(_fightSorcererSpriteIdx)->animData[0].nframes = 1;
-		smokeAnimation(_fightSorcererSpriteIdx, false);
-		_fightInBlockingAnim = false;
+		startSequence(kSequenceSorcererAppears);
 		return;
 	}
 
-	// Phase 2: spell trigger at tick 104 (64 + 40)
-	if (_fightSorcererAppeared && !_fightSpellCast && _fightFrameCounter >= 104) {
-		_fightSpellCast = true;
-		_fightSpellFrameCounter = 0;
-	}
-
-	// Phase 3: wait 40 ticks after spell trigger, then cast
-	if (_fightSpellCast) {
-		_fightSpellFrameCounter++;
-		if (_fightSpellFrameCounter >= 40 && !(_state->getFlag(FLAG_GODS_STANCES) & (1 << idx))) {
-			_fightInBlockingAnim = true;
-
-			int spellFrames = kFightRooms[idx].spellFrames;
-			int framesDone = 0;
-			_room->findSpriteByIndex(_fightSorcererSpriteIdx)->animData[0].nframes = kFightRooms[idx].spellFrames;
-			_room->findSpriteByIndex(_fightSorcererSpriteIdx)->animData[0].speed = 1;
-			_sound->playSound(_room->_roomSfx[1]);
-			while (!shouldQuit() && framesDone < spellFrames) {
-				_events->pollEvent();
-				if (renderScene(OVERLAY_NONE))
-					framesDone++;
-				_screen->update();
-				g_system->delayMillis(10);
-			}
-			_room->findSpriteByIndex(_fightSorcererSpriteIdx)->animData[0].nframes = 1;
-			smokeAnimation(-1, true);
-
-			_fightInBlockingAnim = false;
-
-			_alfredState.x = 294;
-			_alfredState.y = 387;
-			_alfredState.direction = ALFRED_UP;
-			setScreenAndPrepare(49, ALFRED_UP);
-		}
+	// Phase 2: the spell is triggered at tick 104 (64 + 40) and cast 40 idle ticks later
+	if (_fightSorcererAppeared && _fightFrameCounter >= 143) {
+		startSequence(kSequenceSorcererSpell);
 	}
 }
 
@@ -37,6 +37,7 @@
 #include "graphics/screen.h"
 #include "image/png.h"
 
+#include "pelrock/autosave.h"
 #include "pelrock/chrono.h"
 #include "pelrock/detection.h"
 #include "pelrock/dialog.h"
@@ -45,9 +46,12 @@
 #include "pelrock/fonts/small_font.h"
 #include "pelrock/fonts/small_font_double.h"
 #include "pelrock/graphics.h"
+#include "pelrock/memstats.h"
 #include "pelrock/menu.h"
 #include "pelrock/resources.h"
 #include "pelrock/room.h"
+#include "pelrock/saveslots.h"
+#include "pelrock/snapshots.h"
 #include "pelrock/sound.h"
 #include "pelrock/types.h"
 #include "pelrock/video/video.h"
@@ -73,6 +77,8 @@ private:
 	*/
 	void walkTo(int x, int y);
 	void walkAndAction(HotSpot *hotspot, VerbIcon action);
+	/** Sends Alfred to the hotspot with the action queued, without waiting for it. */
+	void startWalkAndAction(HotSpot *hotspot, VerbIcon action);
 	AlfredDirection calculateAlfredsDirection(HotSpot *hotspot);
 
 	Common::Array<VerbIcon> availableActions(HotSpot *hotspot);
@@ -99,6 +105,8 @@ private:
 	void drawIdleFrame();
 	void drawAlfred(byte *buf);
 	void drawNextFrame(Sprite *animSet);
+	/** Whether any sprite with an enabled hotspot moved, changed frame or was hidden since the last call. */
+	bool updateSpriteHitKeys();
 	void animateTalkingNPC(Sprite *animSet);
 	void pickupIconFlash();
 
@@ -110,6 +118,8 @@ private:
 	int checkMouseClickInventoryOverlay(int x, int y);
 
 	void gameLoop();
+	/** Ctrl+S takes a snapshot, Ctrl+L goes back to the newest one and Ctrl+R rewinds past it. */
+	void checkSnapshotKeys();
 	void firstScene();
 	void computerLoop();
 	void extraScreenLoop();
@@ -124,6 +134,8 @@ private:
 	PathContext _currentContext = {nullptr, nullptr, 0, 0, 0};
 
 	ActionPopupState _actionPopupState;
+	SmokeEffectState _smokeState;
+	CutsceneState _cutscene;
 	InventoryOverlayState _inventoryOverlayState;
 
 
@@ -139,7 +151,14 @@ private:
 	bool screenReady = false;
 
 	Common::String _hoveredMapLocation = "";
-	byte *_alfredSprite = nullptr;
+	byte _alfredSprite[kAlfredFrameWidth * kAlfredFrameHeight]; // scaled frame, never larger than the source
+	HitMask _alfredHitMask;
+	const byte *_alfredHitMaskFrame = nullptr; // source frame and scale the mask was built from
+	int _alfredHitMaskScale = -1;
+	HoverCache _hoverCache;
+	uint32 _spriteFrameEpoch = 0; // bumped when a sprite the hover hit test can reach changes
+	Common::Array<uint64> _spriteHitKeys; // per sprite, what that hit test read from it last tick
+	int _activeCursor = -1;
 
 	int _numPressedX = 0;
 
@@ -153,12 +172,11 @@ private:
 	int _fightFrameCounter = 0;
 	int _fightSorcererSpriteIdx = -1;
 	bool _fightSorcererAppeared = false;
-	bool _fightSpellCast = false;
-	int _fightSpellFrameCounter = 0;
-	bool _fightInBlockingAnim = false;
 	bool _disableAmbientSounds = false;
-	bool _isDogPeeing = false;
+	Common::Array<Sequence> _sequences;
+	bool _updatingSequences = false;
 	bool _disableAction = false;
+	uint32 _nextMemoryLogTick = 0;
 
 protected:
 	// Engine APIs
@@ -166,7 +184,7 @@ protected:
 
 public:
 	GraphicsManager *_graphics = nullptr;
-	Graphics::Screen *_screen = nullptr;
+	PelrockScreen *_screen = nullptr;
 	ResourceManager *_res = nullptr;
 	RoomManager *_room = nullptr;
 	ChronoManager *_chrono = nullptr;
@@ -176,7 +194,8 @@ public:
 	ShakeEffectState _shakeEffectState;
 	byte _npcTalkSpeedByte = 0;
 	Graphics::ManagedSurface _compositeBuffer; // Working composition buffer
-	Graphics::ManagedSurface _currentBackground; // Clean background - NEVER modified
+	Graphics::ManagedSurface _currentBackground; // Clean background - only a few scripted events paint into it
+	bool _backgroundModified = false;            // set by those events, the room has to reload it
 	Graphics::ManagedSurface _bgScreen;
 	Graphics::Surface _saveThumbnail;
 
@@ -185,6 +204,11 @@ public:
 	SmallFont *_smallFont = nullptr;
 	LargeFont *_largeFont = nullptr;
 	DoubleSmallFont *_doubleSmallFont = nullptr;
+	PerfStats _perfStats;
+	MemoryStats _memStats;
+	AsyncSaveWriter _autosaveWriter;
+	SnapshotRing _snapshots;
+	SaveSlotCache _saveSlots;
 
 public:
 	PelrockEngine(OSystem *syst, const ADGameDescription *gameDesc);
@@ -197,6 +221,11 @@ public:
 	 */
 	Common::String getGameId() const;
 
+	/**
+	 * Called once the recorded input has been played back; logs the per-room timings.
+	 */
+	void onReplayFinished();
+
 	/**
 	 * Gets a random number
 	 */
@@ -204,6 +233,9 @@ public:
 		return _randomSource.getRandomNumber(maxNum);
 	}
 
+	SoundManager *getSoundManager() { return _sound; }
+	const HoverCache &getHoverCache() const { return _hoverCache; }
+
 	/**
 	 * Returns true if "Alternate timing" option is enabled.
 	 * When false, the engine uses the original game's half-speed walking/talking timing.
@@ -226,9 +258,13 @@ public:
 	}
 
 	bool canSaveAutosaveCurrently() override {
-		return _autoSaveAllowed;
+		return _autoSaveAllowed && !_autosaveWriter.isBusy();
 	}
 
+	/** Autosaves are snapshotted here and written by _autosaveWriter; other saves flush it first. */
+	Common::Error saveGameState(int slot, const Common::String &desc, bool isAutosave = false) override;
+	Common::Error loadGameState(int slot) override;
+
 	/**
 	 * Uses a serializer to allow implementing savegame
 	 * loading and saving using a single method
@@ -239,26 +275,75 @@ public:
 
 	SaveGameData *createSaveGameData() const;
 
-	Common::Error saveGameStream(Common::WriteStream *stream, bool isAutosave = false) override {
-		Common::Serializer s(nullptr, stream);
-		return syncGame(s);
-	}
-	Common::Error loadGameStream(Common::SeekableReadStream *stream) override {
-		Common::Serializer s(stream, nullptr);
-		return syncGame(s);
-	}
+	/** Adds the current state to the snapshot ring; false if nothing changed since the newest one. */
+	bool takeSnapshot();
+	/** Restores the snapshot `age` steps back from the newest, without going through the save files. */
+	bool restoreSnapshot(uint age);
+	/** Drops the newest snapshot and restores the one before it. */
+	bool rewindSnapshot();
+
+	Common::Error saveGameStream(Common::WriteStream *stream, bool isAutosave = false) override;
+	/** Loads the current format and the unversioned one that predates it. */
+	Common::Error loadGameStream(Common::SeekableReadStream *stream) override;
 
-	void setScreen(int s);
-	void setScreenAndPrepare(int s, AlfredDirection dir);
+	/**
+	 * Loads a room. reuseAssets keeps the background and the decoded assets of the room already
+	 * loaded when it is the same one, reapplying only the state that can differ.
+	 */
+	void setScreen(int s, bool reuseAssets = false);
+	void setScreenAndPrepare(int s, AlfredDirection dir, bool reuseAssets = false);
 	void loadExtraScreenAndPresent(int screenIndex);
 	void waitForSpecialAnimation();
-	bool renderScene(int overlayMode = OVERLAY_NONE);
+	/**
+	 * One iteration of a blocking loop: input, scene tick, presentation and pacing.
+	 * Returns how many logic ticks the scene stepped, 0 if none.
+	 */
+	int pumpFrame(int overlayMode = OVERLAY_NONE);
+	void waitTicks(int ticks, int overlayMode = OVERLAY_NONE);
+	/**
+	 * Steps the scene for every tick that is due, catch-up ticks included, and presents the last one.
+	 * Returns the number of ticks stepped; anything counting ticks must add it rather than count calls.
+	 */
+	int renderScene(int overlayMode = OVERLAY_NONE);
+	/** Runs one tick of scene logic and composes it into the composite buffer without presenting. */
+	void stepScene(int overlayMode);
 	void mouseHoverForMap();
 	void frameTriggers();
 	void maybeHaveDogPee();
 	void maybePlayPostIntro();
 	void maybeShakeEffect();
 	void handleFightRoomFrame();
+
+	// Scripted sequences (sequences.cpp)
+	void startSequence(SequenceId id, bool blocksInput = true);
+	bool isSequenceRunning(SequenceId id) const;
+	bool isInputBlockedBySequence() const;
+	void stopSequences();
+	/** Resumes every sequence whose wait is over. Called once per scene tick. */
+	void updateSequences();
+	bool runSequenceStep(Sequence &seq);
+	bool dogPeeStep(Sequence &seq);
+	bool sorcererAppearsStep(Sequence &seq);
+	bool sorcererSpellStep(Sequence &seq);
+	bool brickWindowStep(Sequence &seq);
+	int16 brickWindowDialogueY(int line);
+	bool swimmingPoolStep(Sequence &seq);
+	bool travelToEgyptStep(Sequence &seq);
+	bool pyramidCollapseStep(Sequence &seq);
+	bool endingStep(Sequence &seq);
+	bool creditsStep(Sequence &seq);
+	/** Fades the palette out by one step; true once it is black. */
+	bool fadeOutStep(Sequence &seq, int stepSize);
+	/** Puts an extra screen up in place of the room until hideExtraScreen(). */
+	void showExtraScreen(int screenIndex);
+	void hideExtraScreen();
+	void freeCutsceneAssets();
+	void loadEndingSprites();
+	void showCreditsPage(int page);
+	/** Composes the extra screen a cutscene put up, instead of the room. */
+	void drawExtraScreen();
+	/** Draws what the running cutscenes put over the room. */
+	void drawCutsceneOverlays();
 	void paintDebugLayer();
 
 	void maybeUpdatePasserByAnim(uint32 frameCount);
@@ -272,7 +357,6 @@ public:
 	void doExtraActions(int roomNumber);
 	void pyramidCollapse();
 	void endingScene();
-	void credits();
 	void initGodsSequences(int roomNumber);
 	void addInventoryItem(int item);
 	void buyFromStore(HotSpot *hotspot, int stickerId);
@@ -360,6 +444,7 @@ public:
 	void closeTravelAgencyDoor(HotSpot *hotspot);
 	void usePumpkinWithRiver(int inventoryObject, HotSpot *hotspot);
 	void playAlfredSpecialAnim(int anim, bool reverse = false);
+	void startAlfredSpecialAnim(int anim, bool reverse = false);
 	void waitForSoundEnd(int channel = 0);
 	void pickupSunflower(HotSpot *hotspot);
 	void checkIngredients();
@@ -396,7 +481,12 @@ public:
 	void useWaterOnFakeStone(int inventoryObject, HotSpot *hotspot);
 	void useWigWithPot(int inventoryObject, HotSpot *hotspot);
 	void magicFormula(int inventoryObject, HotSpot *hotspot);
+	/** Plays the smoke effect and waits for it to end. */
 	void smokeAnimation(int spriteIndex, bool hide = true);
+	void startSmokeAnimation(int spriteIndex, bool hide = true);
+	/** Draws the smoke over the presented frame and moves it on by the ticks stepped. */
+	void updateSmokeAnimation(int ticks);
+	void stopSmokeAnimation();
 	// void endgameTransportAnimation();
 	void openArchitectDoor(HotSpot *hotspot);
 	void closeArchitectDoor(HotSpot *hotspot);
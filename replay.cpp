@@ -0,0 +1,187 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/algorithm.h"
+#include "common/system.h"
+
+#include "pelrock/pelrock.h"
+#include "pelrock/replay.h"
+
+namespace Pelrock {
+
+static const uint32 kReplayMagic = MKTAG('P', 'R', 'E', 'C');
+static const byte kReplayVersion = 1;
+
+void PerfStats::addFrame(int room, uint32 ms) {
+	RoomPerfStats &stats = _rooms[room];
+	stats.frames++;
+	stats.frameMs += ms;
+	stats.maxFrameMs = MAX(stats.maxFrameMs, ms);
+}
+
+void PerfStats::addLoad(int room, uint32 ms) {
+	RoomPerfStats &stats = _rooms[room];
+	stats.loads++;
+	stats.loadMs += ms;
+	stats.maxLoadMs = MAX(stats.maxLoadMs, ms);
+}
+
+void PerfStats::addAudio(int room, uint activeChannels, uint32 starts, uint32 steals) {
+	RoomPerfStats &stats = _rooms[room];
+	stats.audioTicks++;
+	stats.activeChannels += activeChannels;
+	stats.maxActiveChannels = MAX<uint32>(stats.maxActiveChannels, activeChannels);
+	stats.soundStarts += starts;
+	stats.steals += steals;
+}
+
+Common::String PerfStats::format() const {
+	Common::Array<int> rooms;
+	for (Common::HashMap<int, RoomPerfStats>::const_iterator it = _rooms.begin(); it != _rooms.end(); ++it) {
+		rooms.push_back(it->_key);
+	}
+	Common::sort(rooms.begin(), rooms.end());
+
+	Common::String out;
+	for (uint i = 0; i < rooms.size(); i++) {
+		const RoomPerfStats &stats = _rooms[rooms[i]];
+		out += Common::String::format("Room %2d: %6u frames, avg %.2f ms, max %u ms | %u loads, avg %.1f ms, max %u ms"
+									  " | channels avg %.2f, max %u, %u sounds, %u stolen\n",
+									  rooms[i], stats.frames, stats.frames ? (float)stats.frameMs / stats.frames : 0.0f, stats.maxFrameMs,
+									  stats.loads, stats.loads ? (float)stats.loadMs / stats.loads : 0.0f, stats.maxLoadMs,
+									  stats.audioTicks ? (float)stats.activeChannels / stats.audioTicks : 0.0f, stats.maxActiveChannels,
+									  stats.soundStarts, stats.steals);
+	}
+	return out;
+}
+
+InputRecorder::~InputRecorder() {
+	stop();
+}
+
+bool InputRecorder::startRecording(const Common::String &name, uint32 seed, uint32 ambientSeed) {
+	stop();
+	{
+		// The autosave writer may be in the savefile manager on the timer thread
+		Common::StackLock lock(g_engine->_autosaveWriter.getIoMutex());
+		_out = g_system->getSavefileManager()->openForSaving(name, false);
+	}
+	if (!_out) {
+		warning("Could not create input recording %s", name.c_str());
+		return false;
+	}
+	_out->writeUint32BE(kReplayMagic);
+	_out->writeByte(kReplayVersion);
+	_out->writeUint32LE(seed);
+	_out->writeUint32LE(ambientSeed);
+	_pollCount = 0;
+	_mode = kModeRecord;
+	return true;
+}
+
+bool InputRecorder::startReplay(const Common::String &name, uint32 &seed, uint32 &ambientSeed) {
+	stop();
+	{
+		Common::StackLock lock(g_engine->_autosaveWriter.getIoMutex());
+		_in = g_system->getSavefileManager()->openForLoading(name);
+	}
+	if (!_in) {
+		warning("Could not open input recording %s", name.c_str());
+		return false;
+	}
+	if (_in->readUint32BE() != kReplayMagic || _in->readByte() != kReplayVersion) {
+		warning("%s is not a supported input recording", name.c_str());
+		delete _in;
+		_in = nullptr;
+		return false;
+	}
+	seed = _in->readUint32LE();
+	ambientSeed = _in->readUint32LE();
+	_pollCount = 0;
+	_groupActive = false;
+	_mode = kModeReplay;
+	readPending();
+	return true;
+}
+
+void InputRecorder::stop() {
+	if (_out) {
+		Common::StackLock lock(g_engine->_autosaveWriter.getIoMutex());
+		_out->finalize();
+		delete _out;
+		_out = nullptr;
+	}
+	delete _in;
+	_in = nullptr;
+	_hasPending = false;
+	_mode = kModeOff;
+}
+
+void InputRecorder::beginPoll(uint32 tick) {
+	_tick = tick;
+	_pollCount++;
+	_groupActive = false;
+}
+
+void InputRecorder::recordEvent(const Common::Event &event) {
+	if (_mode != kModeRecord)
+		return;
+	_out->writeUint32LE(_tick);
+	_out->writeUint32LE(_pollCount);
+	_out->writeByte(event.type);
+	_out->writeSint16LE(event.mouse.x);
+	_out->writeSint16LE(event.mouse.y);
+	_out->writeUint16LE(event.kbd.keycode);
+	_out->writeUint16LE(event.kbd.ascii);
+	_out->writeByte(event.kbd.flags);
+}
+
+void InputRecorder::readPending() {
+	_pendingTick = _in->readUint32LE();
+	_pendingPoll = _in->readUint32LE();
+	_pendingEvent = Common::Event();
+	_pendingEvent.type = (Common::EventType)_in->readByte();
+	_pendingEvent.mouse.x = _in->readSint16LE();
+	_pendingEvent.mouse.y = _in->readSint16LE();
+	_pendingEvent.kbd.keycode = (Common::KeyCode)_in->readUint16LE();
+	_pendingEvent.kbd.ascii = _in->readUint16LE();
+	_pendingEvent.kbd.flags = _in->readByte();
+	_hasPending = !_in->eos() && !_in->err();
+}
+
+bool InputRecorder::nextReplayEvent(Common::Event &event) {
+	if (_mode != kModeReplay || !_hasPending)
+		return false;
+	if (_groupActive) {
+		// Only the rest of the recorded call currently being played back
+		if (_pendingPoll != _activePoll)
+			return false;
+	} else {
+		if (_pendingTick > _tick)
+			return false;
+		_groupActive = true;
+		_activePoll = _pendingPoll;
+	}
+	event = _pendingEvent;
+	readPending();
+	return true;
+}
+
+} // End of namespace Pelrock
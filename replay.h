@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_REPLAY_H
+#define PELROCK_REPLAY_H
+
+#include "common/events.h"
+#include "common/hashmap.h"
+#include "common/savefile.h"
+#include "common/scummsys.h"
+#include "common/str.h"
+
+namespace Pelrock {
+
+struct RoomPerfStats {
+	uint32 frames = 0;
+	uint32 frameMs = 0;
+	uint32 maxFrameMs = 0;
+	uint32 loads = 0;
+	uint32 loadMs = 0;
+	uint32 maxLoadMs = 0;
+	uint32 audioTicks = 0;
+	uint32 activeChannels = 0; // summed over audio ticks
+	uint32 maxActiveChannels = 0;
+	uint32 soundStarts = 0;
+	uint32 steals = 0;
+};
+
+/**
+ * Real time spent presenting frames and loading rooms, and how busy the sound channels were, per room.
+ */
+class PerfStats {
+public:
+	void addFrame(int room, uint32 ms);
+	void addLoad(int room, uint32 ms);
+	void addAudio(int room, uint activeChannels, uint32 starts, uint32 steals);
+	void clear() { _rooms.clear(); }
+	/** One line per room, sorted by room number. */
+	Common::String format() const;
+
+private:
+	Common::HashMap<int, RoomPerfStats> _rooms;
+};
+
+/**
+ * Records the event stream to a file or plays it back in place of live input.
+ * Events are tagged with the logic tick they were read on and the pollEvent() call that read
+ * them. On replay each call receives at most one recorded call's events, and only once its
+ * tick has been reached, so sessions repeat exactly under the fast-forward clock.
+ */
+class InputRecorder {
+public:
+	enum Mode {
+		kModeOff,
+		kModeRecord,
+		kModeReplay
+	};
+
+	~InputRecorder();
+
+	bool startRecording(const Common::String &name, uint32 seed, uint32 ambientSeed);
+	/** Opens a recording and returns the random seeds it was made with. */
+	bool startReplay(const Common::String &name, uint32 &seed, uint32 &ambientSeed);
+	void stop();
+	Mode getMode() const { return _mode; }
+
+	/** Marks the start of a pollEvent() call made on the given logic tick. */
+	void beginPoll(uint32 tick);
+	void recordEvent(const Common::Event &event);
+	/** Returns the next recorded event due on this poll, if any. */
+	bool nextReplayEvent(Common::Event &event);
+	bool isReplayFinished() const { return _mode == kModeReplay && !_hasPending; }
+
+private:
+	void readPending();
+
+	Mode _mode = kModeOff;
+	Common::OutSaveFile *_out = nullptr;
+	Common::InSaveFile *_in = nullptr;
+	uint32 _tick = 0;
+	uint32 _pollCount = 0;
+
+	// Replay lookahead: the next recorded event and the poll group being played back
+	bool _hasPending = false;
+	uint32 _pendingTick = 0;
+	uint32 _pendingPoll = 0;
+	Common::Event _pendingEvent;
+	bool _groupActive = false;
+	uint32 _activePoll = 0;
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_REPLAY_H
@@ -92,40 +92,17 @@ ResourceManager::~ResourceManager() {
 		delete[] _verbIcons[i];
 	}
 	free(_popUpBalloon);
-	for (int i = 0; i < 4; i++) {
-		// free all frame buffers
-		for (int j = 0; j < walkingAnimLengths[i]; j++) {
-			delete[] alfredWalkFrames[i][j];
-			delete[] alfredTalkFrames[i][j];
-		}
-
-		for (int j = 0; j < 2; j++) {
-			delete[] alfredInteractFrames[i][j];
-		}
-
-		// free the array of pointers
-		delete[] alfredWalkFrames[i];
-		delete[] alfredTalkFrames[i];
-		delete[] alfredInteractFrames[i];
-		delete[] alfredIdle[i];
-	}
-
-	for (int i = 0; i < 11; i++) {
-		delete[] alfredCombFrames[0][i];
-		delete[] alfredCombFrames[1][i];
-	}
-	delete[] alfredCombFrames[0];
-	delete[] alfredCombFrames[1];
-
-	for (int i = 0; i < 4; i++) {
-		for (int j = 0; j < 9; j++) {
-			delete[] alfredCrawlFrames[i][j];
-		}
-		delete[] alfredCrawlFrames[i];
-	}
+	// Frame arrays are slices of _alfredFrameTable, frames are views into _alfredAtlas
+	delete[] _alfredFrameTable;
+	delete[] _alfredAtlas;
+	g_engine->_memStats.remove(kMemResources, _alfredAtlasSize);
 
 	delete[] _inventoryIcons;
+	delete[] _inventoryIconSheet;
+	g_engine->_memStats.remove(kMemResources, _inventoryIconSheetSize);
 	clearSpecialAnim();
+	delete[] _specialAnimPool;
+	g_engine->_memStats.remove(kMemResources, _specialAnimPoolSize);
 }
 
 void ResourceManager::loadCursors() {
@@ -175,6 +152,18 @@ void ResourceManager::loadInteractionIcons() {
 	alfred4File.close();
 }
 
+static const int kAlfredStdFrames = 60; // ALFRED.3 standard sheet: 3060x102 of 51x102 frames
+static const int kAlfredCombFrames = 11;  // per side
+static const int kCrawlFrameWidth = 130;
+static const int kCrawlFrameHeight = 55;
+static const int kCrawlFrames = 18; // 9 per side, 2340x55 sheet
+static const int kCrawlFramesPerDirection = 9;
+static const int kAlfredAtlasAlign = 16;
+
+static uint32 atlasSlotSize(uint32 frameSize) {
+	return (frameSize + kAlfredAtlasAlign - 1) & ~(uint32)(kAlfredAtlasAlign - 1);
+}
+
 void ResourceManager::loadAlfredAnims() {
 	Common::File alfred3;
 	if (!alfred3.open(Common::Path("ALFRED.3"))) {
@@ -187,15 +176,68 @@ void ResourceManager::loadAlfredAnims() {
 	alfred3.read(bufferFile, alfred3Size);
 	alfred3.close();
 
-	uint32 capacity = 3060 * 102 + 2340 * 55;
+	int frameSize = kAlfredFrameHeight * kAlfredFrameWidth;
+	int crawlFrameSize = kCrawlFrameWidth * kCrawlFrameHeight;
+	uint32 capacity = kAlfredStdFrames * frameSize + kCrawlFrames * crawlFrameSize;
 	byte *completePic = nullptr;
 	rleDecompress(bufferFile, alfred3Size, 0, capacity, &completePic);
+	free(bufferFile);
 
-	byte *stdFramesPic = new byte[3060 * 102];
-	Common::copy(completePic, completePic + 3060 * 102, stdFramesPic);
-	int frameSize = kAlfredFrameHeight * kAlfredFrameWidth;
+	Common::File alfred7;
+	if (!alfred7.open(Common::Path("ALFRED.7"))) {
+		error("Could not open ALFRED.7");
+		return;
+	}
+	int spriteMapSize = frameSize * kAlfredCombFrames;
+
+	/* Combing */
+	byte *alfredCombRaw[2];
+	size_t alfredCombRawSize[2];
+	byte *alfredComb[2] = {nullptr, nullptr};
+	readUntilBuda(&alfred7, ALFRED7_ALFRED_COMB_R, alfredCombRaw[0], alfredCombRawSize[0]);
+	readUntilBuda(&alfred7, ALFRED7_ALFRED_COMB_L, alfredCombRaw[1], alfredCombRawSize[1]);
+	alfred7.close();
+	for (int side = 0; side < 2; side++) {
+		rleDecompress(alfredCombRaw[side], alfredCombRawSize[side], 0, spriteMapSize, &alfredComb[side]);
+		free(alfredCombRaw[side]);
+	}
+
+	// Every frame Alfred can show goes into one block at its real size, slots aligned for the blitters
+	uint32 stdSlot = atlasSlotSize(frameSize);
+	uint32 crawlSlot = atlasSlotSize(crawlFrameSize);
+	byte *stdBase;
+	byte *combBase[2];
+	byte *crawlBase;
+	delete[] _alfredAtlas;
+	g_engine->_memStats.remove(kMemResources, _alfredAtlasSize);
+	_alfredAtlasSize = (kAlfredStdFrames + 2 * kAlfredCombFrames) * stdSlot + kCrawlFrames * crawlSlot;
+	_alfredAtlas = new byte[_alfredAtlasSize];
+	g_engine->_memStats.add(kMemResources, _alfredAtlasSize);
+	stdBase = _alfredAtlas;
+	combBase[0] = stdBase + kAlfredStdFrames * stdSlot;
+	combBase[1] = combBase[0] + kAlfredCombFrames * stdSlot;
+	crawlBase = combBase[1] + kAlfredCombFrames * stdSlot;
+
+	for (int i = 0; i < kAlfredStdFrames; i++) {
+		memcpy(stdBase + i * stdSlot, frameAt(completePic, i, kAlfredFrameWidth, kAlfredFrameHeight), frameSize);
+	}
+	for (int side = 0; side < 2; side++) {
+		for (int i = 0; i < kAlfredCombFrames; i++) {
+			memcpy(combBase[side] + i * stdSlot, frameAt(alfredComb[side], i, kAlfredFrameWidth, kAlfredFrameHeight), frameSize);
+		}
+		free(alfredComb[side]);
+	}
+	byte *crawlFramesPic = completePic + kAlfredStdFrames * frameSize;
+	for (int i = 0; i < kCrawlFrames; i++) {
+		memcpy(crawlBase + i * crawlSlot, frameAt(crawlFramesPic, i, kCrawlFrameWidth, kCrawlFrameHeight), crawlFrameSize);
+	}
+	free(completePic);
+
+	// All the per-set frame arrays are slices of one table of views into the atlas
+	delete[] _alfredFrameTable;
+	_alfredFrameTable = new byte *[kAlfredFrameTableSize];
+	byte **table = _alfredFrameTable;
 	for (int i = 0; i < 4; i++) {
-		alfredIdle[i] = new byte[frameSize];
 		int talkingFramesOffset = walkingAnimLengths[0] + walkingAnimLengths[1] + walkingAnimLengths[2] + walkingAnimLengths[3] + 4;
 		int interactingFramesOffset = talkingFramesOffset + talkingAnimLengths[0] + talkingAnimLengths[1] + talkingAnimLengths[2] + talkingAnimLengths[3];
 		int prevWalkingFrames = 0;
@@ -208,93 +250,46 @@ void ResourceManager::loadAlfredAnims() {
 			prevInteractingFrames += interactingAnimLength;
 		}
 
-		alfredWalkFrames[i] = new byte *[walkingAnimLengths[i]];
-
 		int standingFrame = prevWalkingFrames;
+		alfredIdle[i] = stdBase + standingFrame * stdSlot;
 
-		extractSingleFrame(stdFramesPic, alfredIdle[i], standingFrame, kAlfredFrameWidth, kAlfredFrameHeight);
+		alfredWalkFrames[i] = table;
+		table += walkingAnimLengths[i];
 		for (int j = 0; j < walkingAnimLengths[i]; j++) {
-
-			alfredWalkFrames[i][j] = new byte[frameSize];
 			int walkingFrame = prevWalkingFrames + 1 + j;
-			extractSingleFrame(stdFramesPic, alfredWalkFrames[i][j], walkingFrame, kAlfredFrameWidth, kAlfredFrameHeight);
+			alfredWalkFrames[i][j] = stdBase + walkingFrame * stdSlot;
 		}
 
-		alfredTalkFrames[i] = new byte *[talkingAnimLengths[i]];
-
+		alfredTalkFrames[i] = table;
+		table += talkingAnimLengths[i];
 		int talkingStartFrame = talkingFramesOffset + prevTalkingFrames;
 		for (int j = 0; j < talkingAnimLengths[i]; j++) {
-			alfredTalkFrames[i][j] = new byte[frameSize];
-			int talkingFrame = talkingStartFrame + j;
-			extractSingleFrame(stdFramesPic, alfredTalkFrames[i][j], talkingFrame, kAlfredFrameWidth, kAlfredFrameHeight);
+			alfredTalkFrames[i][j] = stdBase + (talkingStartFrame + j) * stdSlot;
 		}
 
-		alfredInteractFrames[i] = new byte *[interactingAnimLength];
+		alfredInteractFrames[i] = table;
+		table += interactingAnimLength;
 		int interactingStartFrame = interactingFramesOffset + prevInteractingFrames;
 		for (int j = 0; j < interactingAnimLength; j++) {
-			alfredInteractFrames[i][j] = new byte[frameSize];
-			int interactingFrame = interactingStartFrame + j;
-			extractSingleFrame(stdFramesPic, alfredInteractFrames[i][j], interactingFrame, kAlfredFrameWidth, kAlfredFrameHeight);
+			alfredInteractFrames[i][j] = stdBase + (interactingStartFrame + j) * stdSlot;
 		}
-	}
 
-	byte *crawlFramesPic = new byte[2340 * 55];
-	Common::copy(completePic + 3060 * 102, completePic + 3060 * 102 + 2340 * 55, crawlFramesPic);
-	int crawlFrameSize = 2340 * 55;
-	for (int i = 0; i < 4; i++) {
-		alfredCrawlFrames[i] = new byte *[9];
-		for (int j = 0; j < 9; j++) {
-			int walkingFrame = (i % 2) * 9 + j;
-			alfredCrawlFrames[i][j] = new byte[crawlFrameSize];
-			extractSingleFrame(crawlFramesPic, alfredCrawlFrames[i][j], walkingFrame, 130, 55);
+		alfredCrawlFrames[i] = table;
+		table += kCrawlFramesPerDirection;
+		for (int j = 0; j < kCrawlFramesPerDirection; j++) {
+			int crawlFrame = (i % 2) * kCrawlFramesPerDirection + j;
+			alfredCrawlFrames[i][j] = crawlBase + crawlFrame * crawlSlot;
 		}
 	}
 
-	delete[] crawlFramesPic;
-	delete[] stdFramesPic;
-	free(completePic);
-	free(bufferFile);
-
-	Common::File alfred7;
-	if (!alfred7.open(Common::Path("ALFRED.7"))) {
-		error("Could not open ALFRED.7");
-		return;
-	}
-	int spriteMapSize = frameSize * 11;
-
-	/* Combing */
-	byte *alfredCombRightRaw;
-	size_t alfredCombRightSize;
-
-	readUntilBuda(&alfred7, ALFRED7_ALFRED_COMB_R, alfredCombRightRaw, alfredCombRightSize);
-	byte *alfredCombRight = nullptr;
-	rleDecompress(alfredCombRightRaw, alfredCombRightSize, 0, spriteMapSize, &alfredCombRight);
-
-	alfredCombFrames[0] = new byte *[11];
-	alfredCombFrames[1] = new byte *[11];
-
-	for (int i = 0; i < 11; i++) {
-		alfredCombFrames[0][i] = new byte[frameSize];
-		extractSingleFrame(alfredCombRight, alfredCombFrames[0][i], i, kAlfredFrameWidth, kAlfredFrameHeight);
-	}
-
-	byte *alfredCombLeftRaw;
-	size_t alfredCombLeftSize;
-	readUntilBuda(&alfred7, ALFRED7_ALFRED_COMB_L, alfredCombLeftRaw, alfredCombLeftSize);
-	byte *alfredCombLeft = nullptr;
-	rleDecompress(alfredCombLeftRaw, alfredCombLeftSize, 0, spriteMapSize, &alfredCombLeft);
-
-	for (int i = 0; i < 11; i++) {
-		alfredCombFrames[1][i] = new byte[frameSize];
-		extractSingleFrame(alfredCombLeft, alfredCombFrames[1][i], i, kAlfredFrameWidth, kAlfredFrameHeight);
+	for (int side = 0; side < 2; side++) {
+		alfredCombFrames[side] = table;
+		table += kAlfredCombFrames;
+		for (int i = 0; i < kAlfredCombFrames; i++) {
+			alfredCombFrames[side][i] = combBase[side] + i * stdSlot;
+		}
 	}
-
-	free(alfredCombRight);
-	free(alfredCombLeft);
-	free(alfredCombRightRaw);
-	free(alfredCombLeftRaw);
-
-	alfred7.close();
+	assert(table == _alfredFrameTable + kAlfredFrameTableSize);
 }
 
 void ResourceManager::loadOtherSpecialAnim(uint32 offset, bool rleCompressed, byte *&buffer, size_t &bufferSize) {
@@ -327,39 +322,34 @@ void ResourceManager::loadAlfredSpecialAnim(int numAnim, bool reverse) {
 	}
 
 	alfredFile.seek(anim.offset, SEEK_SET);
-	if (_currentSpecialAnim)
-		delete _currentSpecialAnim;
+	clearSpecialAnim();
 	_currentSpecialAnim = new AlfredSpecialAnim(anim.numFrames, anim.w, anim.h, anim.numBudas, anim.offset, anim.loops, anim.size, anim.speed);
 	uint32 size = anim.size == 0 ? anim.numFrames * anim.w * anim.h : anim.size;
-	_currentSpecialAnim->animData = new byte[size];
+	if (size > _specialAnimPoolSize) {
+		delete[] _specialAnimPool;
+		g_engine->_memStats.remove(kMemResources, _specialAnimPoolSize);
+		_specialAnimPool = new byte[size];
+		_specialAnimPoolSize = size;
+		g_engine->_memStats.add(kMemResources, _specialAnimPoolSize);
+	}
+	_currentSpecialAnim->animData = _specialAnimPool;
 	if (anim.numBudas > 0) {
 		byte *thisBlock = nullptr;
 		size_t blockSize = 0;
 		readUntilBuda(&alfredFile, anim.offset, thisBlock, blockSize);
-		rleDecompress(thisBlock, blockSize, 0, size, &_currentSpecialAnim->animData, false);
+		rleDecompressInto(thisBlock, blockSize, 0, _specialAnimPool, size);
 		free(thisBlock);
 	} else {
 		alfredFile.read(_currentSpecialAnim->animData, anim.numFrames * anim.w * anim.h);
 	}
-	if (reverse) {
-		// reverse frames for testing
-		byte *reversedData = new byte[anim.numFrames * anim.w * anim.h];
-		for (int i = 0; i < anim.numFrames; i++) {
-			extractSingleFrame(_currentSpecialAnim->animData,
-							   &reversedData[i * anim.w * anim.h],
-							   anim.numFrames - 1 - i,
-							   anim.w,
-							   anim.h);
-		}
-		delete[] _currentSpecialAnim->animData;
-		_currentSpecialAnim->animData = reversedData;
-	}
+	_currentSpecialAnim->reversed = reverse;
 
 	_isSpecialAnimFinished = false;
 	alfredFile.close();
 }
 
 void ResourceManager::clearSpecialAnim() {
+	// The frames stay in the pool for the next anim
 	delete _currentSpecialAnim;
 	_currentSpecialAnim = nullptr;
 }
@@ -371,15 +361,18 @@ void ResourceManager::loadInventoryItems() {
 		error("Couldnt find file ALFRED.4");
 	}
 	uint32 iconsSize = alfred4File.size() - kInventoryIconsTailSize;
-	byte *iconData = new byte[iconsSize];
+	delete[] _inventoryIconSheet;
+	g_engine->_memStats.remove(kMemResources, _inventoryIconSheetSize);
+	_inventoryIconSheet = new byte[iconsSize];
+	_inventoryIconSheetSize = iconsSize;
+	g_engine->_memStats.add(kMemResources, _inventoryIconSheetSize);
 	alfred4File.seek(kInventoryIconsOffset, SEEK_SET);
-	alfred4File.read(iconData, iconsSize);
+	alfred4File.read(_inventoryIconSheet, iconsSize);
 
 	for (int i = 0; i < 69; i++) {
 		_inventoryIcons[i].index = i;
-		extractSingleFrame(iconData, _inventoryIcons[i].iconData, i, 60, 60);
+		_inventoryIcons[i].iconData = frameAt(_inventoryIconSheet, i, 60, 60);
 	}
-	delete[] iconData;
 }
 
 void ResourceManager::loadHardcodedText() {
@@ -525,22 +518,30 @@ Common::Array<Common::StringArray> ResourceManager::processTextData(byte *data,
 	return texts;
 }
 
-Pelrock::Sticker ResourceManager::getSticker(int stickerIndex) {
+void ResourceManager::loadStickerHeaders() {
 	Common::File alfred6File;
 	if (!alfred6File.open("ALFRED.6")) {
 		error("Couldnt find file ALFRED.6");
 	}
 
-	uint32 stickerOffset = stickerOffsets[stickerIndex];
-	alfred6File.seek(stickerOffset, SEEK_SET);
-	Sticker sticker;
-	sticker.x = alfred6File.readUint16LE();
-	sticker.y = alfred6File.readUint16LE();
-	sticker.w = alfred6File.readByte();
-	sticker.h = alfred6File.readByte();
-	sticker.stickerIndex = stickerIndex;
+	for (int i = 0; i < kNumStickers; i++) {
+		alfred6File.seek(stickerOffsets[i], SEEK_SET);
+		Sticker &sticker = _stickerHeaders[i];
+		sticker.x = alfred6File.readUint16LE();
+		sticker.y = alfred6File.readUint16LE();
+		sticker.w = alfred6File.readByte();
+		sticker.h = alfred6File.readByte();
+		sticker.stickerIndex = i;
+	}
 	alfred6File.close();
-	return sticker;
+	_stickerHeadersLoaded = true;
+}
+
+Pelrock::Sticker ResourceManager::getSticker(int stickerIndex) {
+	// Saves resolve every sticker of every room, so the headers are kept resident
+	if (!_stickerHeadersLoaded)
+		loadStickerHeaders();
+	return _stickerHeaders[stickerIndex];
 }
 
 byte *ResourceManager::loadStickerPixels(const Sticker &sticker) {
@@ -551,6 +552,8 @@ byte *ResourceManager::loadStickerPixels(const Sticker &sticker) {
 	uint32 pixelOffset = stickerOffsets[sticker.stickerIndex] + 6; // skip x(2)+y(2)+w(1)+h(1)
 	alfred6File.seek(pixelOffset, SEEK_SET);
 	byte *pixels = new byte[sticker.w * sticker.h];
+	// Owned and freed by RoomManager, so counted against the room
+	g_engine->_memStats.add(kMemRoom, sticker.w * sticker.h);
 	alfred6File.read(pixels, sticker.w * sticker.h);
 	alfred6File.close();
 	return pixels;
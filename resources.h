@@ -31,10 +31,23 @@ namespace Pelrock {
 static const int walkingAnimLengths[4] = {8, 8, 4, 4}; // size of each inner array
 static const int talkingAnimLengths[4] = {8, 8, 4, 4}; // size of each inner array
 static const int interactingAnimLength = 2;
+// walk + talk + interact + crawl views for 4 directions, plus 2 sides of combing
+static const int kAlfredFrameTableSize = 8 + 8 + 4 + 4 + 8 + 8 + 4 + 4 + 4 * 2 + 4 * 9 + 2 * 11;
 
 class ResourceManager {
 private:
 	InventoryObject *_inventoryIcons = nullptr;
+	byte *_inventoryIconSheet = nullptr;
+	uint32 _inventoryIconSheetSize = 0;
+	byte *_alfredAtlas = nullptr;          // every Alfred frame, at its real size
+	uint32 _alfredAtlasSize = 0;
+	byte **_alfredFrameTable = nullptr;    // backing store of the per-set frame arrays below
+	byte *_specialAnimPool = nullptr;     // decode buffer shared by all special anims, grown as needed
+	uint32 _specialAnimPoolSize = 0;
+	Sticker _stickerHeaders[kNumStickers]; // placement of every sticker, read from ALFRED.6 in one pass
+	bool _stickerHeadersLoaded = false;
+
+	void loadStickerHeaders();
 
 public:
 	ResourceManager(/* args */);
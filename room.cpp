@@ -20,6 +20,7 @@
  */
 #include "common/scummsys.h"
 
+#include "pelrock/pathfinding.h"
 #include "pelrock/pelrock.h"
 #include "pelrock/room.h"
 #include "pelrock/util.h"
@@ -28,6 +29,29 @@
 namespace Pelrock {
 
 static const uint32 kPaletteRemapOffset = 0x4C77C; // JUEGO.EXE — water-effect palette remap table
+static const int kHotspotCountOffset = 0x47a;        // pair 10
+static const int kWalkboxCountOffset = 0x213;        // pair 10
+static const int kWalkboxDataOffset = 0x218;         // pair 10, 9-byte records
+
+static void readHotspotRecord(const byte *data, int i, HotSpot &spot) {
+	int hotspotOffset = kHotspotCountOffset + 2 + i * 9;
+	spot.actionFlags = data[hotspotOffset];
+	spot.x = READ_LE_INT16(data + hotspotOffset + 1);
+	spot.y = READ_LE_INT16(data + hotspotOffset + 3);
+	spot.w = data[hotspotOffset + 5];
+	spot.h = data[hotspotOffset + 6];
+	spot.isSprite = false;
+	spot.extra = READ_LE_INT16(data + hotspotOffset + 7);
+}
+
+static void readWalkboxRecord(const byte *data, int i, WalkBox &box) {
+	uint32 boxOffset = kWalkboxDataOffset + i * 9;
+	box.x = READ_LE_INT16(data + boxOffset);
+	box.y = READ_LE_INT16(data + boxOffset + 2);
+	box.w = READ_LE_INT16(data + boxOffset + 4);
+	box.h = READ_LE_INT16(data + boxOffset + 6);
+	box.flags = data[boxOffset + 8];
+}
 
 RoomManager::RoomManager() {
 	loadWaterPaletteRemap();
@@ -35,10 +59,7 @@ RoomManager::RoomManager() {
 
 RoomManager::~RoomManager() {
 	clearRoomStickerPixels();
-	if (_pixelsShadows != nullptr) {
-		free(_pixelsShadows);
-		_pixelsShadows = nullptr;
-	}
+	clearShadowMap();
 	clearAnims();
 	clearTalkingAnims();
 	delete[] _resetData;
@@ -50,42 +71,62 @@ RoomManager::~RoomManager() {
 	}
 	if(_conversationData) {
 		delete[] _conversationData;
+		g_engine->_memStats.remove(kMemRoom, _conversationDataSize);
 	}
 }
 
 void RoomManager::clearTalkingAnims() {
-	for (int i = 0; i < _talkingAnims.numFramesAnimA; i++)
-		delete[] _talkingAnims.animA[i];
-	delete[] _talkingAnims.animA;
-	for (int i = 0; i < _talkingAnims.numFramesAnimB; i++)
-		delete[] _talkingAnims.animB[i];
-	delete[] _talkingAnims.animB;
+	// Frame tables live in the talk arena, the frames themselves in the pixel data
+	_talkArena.reset();
+	free(_talkingPixelData);
+	_talkingPixelData = nullptr;
+	g_engine->_memStats.remove(kMemRoom, _talkingPixelDataSize);
+	_talkingPixelDataSize = 0;
 	_talkingAnims.animA = nullptr;
 	_talkingAnims.animB = nullptr;
 }
 
-void RoomManager::clearAnims() {
+void RoomManager::clearAnims(bool keepPixelData) {
 	for (auto &sprite : _currentRoomAnims) {
 		if (sprite.animData) {
 			for (int a = 0; a < sprite.numAnims; a++) {
-				for (int f = 0; f < sprite.animData[a].nframes; f++) {
-					delete[] sprite.animData[a].animData[f]; // free each frame
-				}
-				delete[] sprite.animData[a].animData; // free frame pointer array
+				freeAnimHitMasks(sprite.animData[a]);
 			}
 			delete[] sprite.animData; // free anim array
 		}
 	}
+	_currentRoomAnims.clear();
+	// Frame tables live in the sprite arena, the frames themselves in the pixel data
+	_spriteArena.reset();
+	if (keepPixelData)
+		return;
+	free(_roomPixelData);
+	_roomPixelData = nullptr;
+	g_engine->_memStats.remove(kMemRoom, _roomPixelDataSize);
+	_roomPixelDataSize = 0;
 }
 
 void RoomManager::clearRoomStickerPixels() {
 	for (uint i = 0; i < _roomStickerPixelData.size(); i++) {
 		delete[] _roomStickerPixelData[i];
+		g_engine->_memStats.remove(kMemRoom, _roomStickers[i].w * _roomStickers[i].h);
 	}
 	_roomStickerPixelData.clear();
 	_roomStickers.clear();
 }
 
+byte *RoomManager::takeStickerPixels(int stickerIndex) {
+	for (uint i = 0; i < _roomStickers.size(); i++) {
+		if (_roomStickers[i].stickerIndex == stickerIndex) {
+			byte *pixels = _roomStickerPixelData[i];
+			_roomStickers.remove_at(i);
+			_roomStickerPixelData.remove_at(i);
+			return pixels;
+		}
+	}
+	return nullptr;
+}
+
 void RoomManager::loadWaterPaletteRemap() {
 	// Extra remap for water effect
 	Common::File exe;
@@ -178,6 +219,7 @@ void RoomManager::removeStickerFromRoom(byte room, int stickerId) {
 	for (uint i = 0; i < _roomStickers.size(); i++) {
 		if (_roomStickers[i].stickerIndex == stickerId) {
 			delete[] _roomStickerPixelData[i];
+			g_engine->_memStats.remove(kMemRoom, _roomStickers[i].w * _roomStickers[i].h);
 			_roomStickerPixelData.remove_at(i);
 			_roomStickers.remove_at(i);
 			break;
@@ -224,6 +266,7 @@ void RoomManager::changeExit(byte index, bool enabled, int persist) {
 void RoomManager::changeExit(byte room, byte index, bool enabled, int persist) {
 	if (room == _currentRoomNumber && persist & PERSIST_TEMP) {
 		_currentRoomExits[index].isEnabled = enabled;
+		_mutationEpoch++;
 	}
 	if (persist & PERSIST_PERM)
 		g_engine->_state->roomExitChanges[room].push_back({room, index, enabled});
@@ -252,6 +295,8 @@ void RoomManager::changeWalkBox(WalkBox walkbox, int persist) {
 void RoomManager::changeWalkbox(byte room, WalkBox walkbox, int persist) {
 	if (room == _currentRoomNumber && persist & PERSIST_TEMP) {
 		_currentRoomWalkboxes[walkbox.index] = walkbox;
+		_hitIndex.invalidate();
+		_mutationEpoch++;
 	}
 	if (persist & PERSIST_PERM) {
 		g_engine->_state->roomWalkBoxChanges[room].push_back({room, walkbox.index, walkbox});
@@ -267,6 +312,8 @@ void RoomManager::changeHotspot(byte room, HotSpot hotspot, int persist) {
 		for (uint i = 0; i < _currentRoomHotspots.size(); i++) {
 			if (!_currentRoomHotspots[i].isSprite && _currentRoomHotspots[i].innerIndex == hotspot.innerIndex) {
 				_currentRoomHotspots[i] = hotspot;
+				_hitIndex.invalidate();
+				_mutationEpoch++;
 				break;
 			}
 		}
@@ -282,11 +329,11 @@ void RoomManager::disableSprite(byte spriteIndex, int persist) {
 
 void RoomManager::disableSprite(byte roomNumber, byte spriteIndex, int persist) {
 	if (roomNumber == _currentRoomNumber && persist & PERSIST_TEMP) {
-		// Search by sprite.index, not by array position: sortAnimsByZOrder reorders the
-		// array every frame so a raw array index is unreliable.
+		// Search by sprite.index rather than assuming it matches the array position.
 		for (uint i = 0; i < _currentRoomAnims.size(); i++) {
 			if (_currentRoomAnims[i].index == spriteIndex) {
 				_currentRoomAnims[i].zOrder = 255;
+				_mutationEpoch++;
 				break;
 			}
 		}
@@ -309,10 +356,11 @@ void RoomManager::enableSprite(byte roomNumber, byte spriteIndex, byte zOrder, i
 	}
 
 	if (roomNumber == _currentRoomNumber && persist & PERSIST_TEMP) {
-		// Search by sprite.index field, not by array position (array is re-sorted every frame).
+		// Search by sprite.index field rather than assuming it matches the array position.
 		for (uint i = 0; i < _currentRoomAnims.size(); i++) {
 			if (_currentRoomAnims[i].index == spriteIndex) {
 				_currentRoomAnims[i].zOrder = zOrder;
+				_mutationEpoch++;
 				break;
 			}
 		}
@@ -329,6 +377,7 @@ void RoomManager::enableHotspot(HotSpot *hotspot, int persist) {
 void RoomManager::enableHotspot(byte room, HotSpot *hotspot, int persist) {
 	if (persist & PERSIST_TEMP && room == _currentRoomNumber) {
 		hotspot->isEnabled = true;
+		_mutationEpoch++;
 	}
 	if (persist & PERSIST_PERM) {
 		changeHotspot(room, *hotspot);
@@ -342,6 +391,7 @@ void RoomManager::disableHotspot(HotSpot *hotspot, int persist) {
 void RoomManager::disableHotspot(byte room, HotSpot *hotspot, int persist) {
 	if (persist & PERSIST_TEMP && room == _currentRoomNumber) {
 		hotspot->isEnabled = false;
+		_mutationEpoch++;
 	}
 	if (persist & PERSIST_PERM) {
 		changeHotspot(room, *hotspot);
@@ -352,6 +402,8 @@ void RoomManager::moveHotspot(HotSpot *hotspot, int16 newX, int16 newY, int pers
 	if (persist & PERSIST_TEMP) {
 		hotspot->x = newX;
 		hotspot->y = newY;
+		_hitIndex.invalidate();
+		_mutationEpoch++;
 	}
 	if (persist & PERSIST_PERM) {
 		changeHotspot(_currentRoomNumber, *hotspot, persist);
@@ -361,6 +413,7 @@ void RoomManager::moveHotspot(HotSpot *hotspot, int16 newX, int16 newY, int pers
 void RoomManager::setActionMask(HotSpot *hotspot, byte actionMask, int persist) {
 	if (persist & PERSIST_TEMP) {
 		hotspot->actionFlags = actionMask;
+		_mutationEpoch++;
 	}
 	if (persist & PERSIST_PERM) {
 		changeHotspot(_currentRoomNumber, *hotspot, persist);
@@ -370,6 +423,8 @@ void RoomManager::setActionMask(HotSpot *hotspot, byte actionMask, int persist)
 void RoomManager::addWalkbox(WalkBox walkbox, int persist) {
 	if (persist & PERSIST_TEMP) {
 		_currentRoomWalkboxes.push_back(walkbox);
+		_hitIndex.invalidate();
+		_mutationEpoch++;
 	}
 	if (persist & PERSIST_PERM) {
 		g_engine->_state->roomWalkBoxChanges[_currentRoomNumber].push_back({_currentRoomNumber, walkbox.index, walkbox});
@@ -412,6 +467,52 @@ HotSpot *RoomManager::findHotspotByExtra(uint16 extra) {
 	return nullptr;
 }
 
+const HitIndex &RoomManager::getHitIndex() {
+	if (_hitIndex.isDirty()) {
+		_hitIndex.build(_currentRoomHotspots, _currentRoomExits, _currentRoomWalkboxes);
+	}
+	return _hitIndex;
+}
+
+byte RoomManager::findWalkboxAt(int x, int y) {
+	const Common::Array<byte> &candidates = getHitIndex().walkboxesAt(x, y);
+	for (uint i = 0; i < candidates.size(); i++) {
+		if (isPointInWalkbox(&_currentRoomWalkboxes[candidates[i]], x, y)) {
+			return candidates[i];
+		}
+	}
+	return 0xFF;
+}
+
+const Common::Array<byte> &RoomManager::getDrawOrder() {
+	if (_drawOrder.size() != _currentRoomAnims.size()) {
+		_drawOrder.resize(_currentRoomAnims.size());
+		for (uint i = 0; i < _drawOrder.size(); i++) {
+			_drawOrder[i] = i;
+		}
+	}
+
+	// zOrder is written directly all over the place, so check the order instead of tracking every write.
+	// It only changes a handful of times per room, when it does a stable insertion sort puts it back.
+	bool sorted = true;
+	for (uint i = 1; i < _drawOrder.size() && sorted; i++) {
+		sorted = _currentRoomAnims[_drawOrder[i - 1]].zOrder >= _currentRoomAnims[_drawOrder[i]].zOrder;
+	}
+	if (!sorted) {
+		for (uint i = 1; i < _drawOrder.size(); i++) {
+			byte key = _drawOrder[i];
+			byte z = _currentRoomAnims[key].zOrder;
+			uint j = i;
+			while (j > 0 && _currentRoomAnims[_drawOrder[j - 1]].zOrder < z) {
+				_drawOrder[j] = _drawOrder[j - 1];
+				j--;
+			}
+			_drawOrder[j] = key;
+		}
+	}
+	return _drawOrder;
+}
+
 PaletteAnim *RoomManager::getPaletteAnimForRoom(int roomNumber) {
 	Common::File exeFile;
 
@@ -533,13 +634,9 @@ Common::Array<Exit> RoomManager::loadExits(byte *data, size_t size) {
 }
 
 Common::Array<HotSpot> RoomManager::loadHotspots(byte *data, size_t size) {
-	int pair10StartingPos = 0x47a;
-
-	byte hotspot_count = data[pair10StartingPos];
-	int hotspotsDataStart = pair10StartingPos + 2;
+	byte hotspot_count = data[kHotspotCountOffset];
 	Common::Array<HotSpot> hotspots;
 	for (int i = 0; i < hotspot_count; i++) {
-		int hotspotOffset = hotspotsDataStart + i * 9;
 		HotSpot spot;
 		spot.innerIndex = i;
 		spot.index = i;
@@ -556,13 +653,7 @@ Common::Array<HotSpot> RoomManager::loadHotspots(byte *data, size_t size) {
 		}
 		if (isChanged)
 			continue;
-		spot.actionFlags = data[hotspotOffset];
-		spot.x = READ_LE_INT16(data + hotspotOffset + 1);
-		spot.y = READ_LE_INT16(data + hotspotOffset + 3);
-		spot.w = data[hotspotOffset + 5];
-		spot.h = data[hotspotOffset + 6];
-		spot.isSprite = false;
-		spot.extra = READ_LE_INT16(data + hotspotOffset + 7);
+		readHotspotRecord(data, i, spot);
 		hotspots.push_back(spot);
 	}
 
@@ -600,7 +691,8 @@ void RoomManager::resetConversationStates(byte roomNumber, byte *conversationDat
 	alfredB.close();
 }
 
-void RoomManager::loadRoomMetadata(Common::File *roomFile, int roomNumber) {
+void RoomManager::loadRoomMetadata(Common::File *roomFile, int roomNumber, bool reuseAssets) {
+	reuseAssets = reuseAssets && isRoomLoaded(roomNumber);
 
 	_prevRoomNumber = _currentRoomNumber;
 	_currentRoomNumber = roomNumber;
@@ -611,7 +703,12 @@ void RoomManager::loadRoomMetadata(Common::File *roomFile, int roomNumber) {
 	// Pair 8 - Animation Pixel Data
 	byte *pic = nullptr;
 	size_t pixelDataSize = 0;
-	loadAnimationPixelData(roomFile, roomOffset, pic, pixelDataSize);
+	if (reuseAssets) {
+		pic = _roomPixelData;
+		pixelDataSize = _roomPixelDataSize;
+	} else {
+		loadAnimationPixelData(roomFile, roomOffset, pic, pixelDataSize);
+	}
 
 	// Pair 9 - Music and sound
 	_musicTrack = loadMusicTrackForRoom(roomFile, roomOffset);
@@ -629,26 +726,41 @@ void RoomManager::loadRoomMetadata(Common::File *roomFile, int roomNumber) {
 
 	// The user's game can be in any state so we reset to defaults first
 	resetMetadataDefaults(roomNumber, pair10, pair10size);
+	if (!_pristineMetadata.contains(roomNumber))
+		_pristineMetadata[roomNumber] = Common::Array<byte>(pair10, pair10size);
+
+	// clear anims from previous room, the new ones reuse its arena
+	clearAnims(reuseAssets);
 
 	Common::Array<Sprite> sprites = loadRoomAnimations(pic, pixelDataSize, pair10, pair10size);
 	Common::Array<HotSpot> staticHotspots = loadHotspots(pair10, pair10size);
 
-	free(pic);
-
-	// clear anims from previous room
-	clearAnims();
+	// Sprite frames point straight into the decompressed pixel data
+	if (!reuseAssets) {
+		_roomPixelData = pic;
+		_roomPixelDataSize = pixelDataSize;
+		g_engine->_memStats.add(kMemRoom, _roomPixelDataSize);
+	}
 
 	_currentRoomAnims = sprites;
+	_drawOrder.clear();
 	_currentRoomHotspots = unifyHotspots(sprites, staticHotspots);
 	_currentRoomExits = loadExits(pair10, pair10size);
 	_currentRoomWalkboxes = loadWalkboxes(pair10, pair10size);
 	_scaleParams = loadScalingParams(pair10, pair10size);
-
-	clearRoomStickerPixels(); // free all sticker buffers first
-	_roomStickers = g_engine->_state->stickersPerRoom[roomNumber];
-	for (uint i = 0; i < _roomStickers.size(); i++) {
-		_roomStickerPixelData.push_back(g_engine->_res->loadStickerPixels(_roomStickers[i]));
-	}
+	_hitIndex.build(_currentRoomHotspots, _currentRoomExits, _currentRoomWalkboxes);
+	_mutationEpoch++;
+
+	// Stickers already on screen keep their pixels, only the missing ones are read
+	Common::Array<Sticker> stickers = g_engine->_state->stickersPerRoom[roomNumber];
+	Common::Array<byte *> stickerPixels;
+	for (uint i = 0; i < stickers.size(); i++) {
+		byte *pixels = takeStickerPixels(stickers[i].stickerIndex);
+		stickerPixels.push_back(pixels ? pixels : g_engine->_res->loadStickerPixels(stickers[i]));
+	}
+	clearRoomStickerPixels(); // free the ones no longer in the room
+	_roomStickers = stickers;
+	_roomStickerPixelData = stickerPixels;
 	// Pair 11 is the palette, already loaded
 
 	// Pair 12 - Room Texts
@@ -666,11 +778,11 @@ void RoomManager::loadRoomMetadata(Common::File *roomFile, int roomNumber) {
 	_conversationOffset = loadDescriptions(pair12, pair12size, _currentRoomDescriptions);
 	loadConversationData(pair12, pair12size, _conversationOffset, _conversationDataSize, _conversationData);
 
-	if (_pixelsShadows != nullptr)
-		free(_pixelsShadows);
-	_pixelsShadows = loadShadowMap(roomNumber);
-
-	loadRemaps(roomNumber);
+	if (!reuseAssets) {
+		clearShadowMap();
+		_pixelsShadows = loadShadowMap(roomNumber);
+		loadRemaps(roomNumber);
+	}
 
 	for (uint i = 0; i < _currentRoomHotspots.size(); i++) {
 		HotSpot hotspot = _currentRoomHotspots[i];
@@ -692,6 +804,7 @@ void RoomManager::loadRoomMetadata(Common::File *roomFile, int roomNumber) {
 		delete _passerByAnims;
 	}
 	_passerByAnims = loadPasserByAnims(roomNumber);
+	_roomLoaded = true;
 
 	delete[] pair10;
 	delete[] pair12;
@@ -946,7 +1059,7 @@ void RoomManager::loadAnimationPixelData(Common::File *roomFile, int roomOffset,
 			outSize = rleDecompress(pixelData, size, 0, size, &buffer, true);
 		} else {
 			// room 40 has uncompressed animation data for some reason
-			buffer = new byte[size];
+			buffer = (byte *)malloc(size);
 			Common::copy(pixelData, pixelData + size, buffer);
 			outSize = size;
 		}
@@ -963,6 +1076,20 @@ Common::Array<Sprite> RoomManager::loadRoomAnimations(byte *pixelData, size_t pi
 	uint32 picOffset = 0;
 
 	Common::Array<SpriteChange> spriteChanges = g_engine->_state->spriteChanges[_currentRoomNumber];
+
+	// Size the arena for every frame table up front so the room fits in one block
+	uint32 arenaSize = 0;
+	for (int i = 0; i < spriteCount; i++) {
+		uint32 animOffset = metadata_start + (i * 44);
+		int numAnims = data[animOffset + 8];
+		if (numAnims == 0)
+			break;
+		for (int j = 0; j < numAnims; j++) {
+			arenaSize += FrameArena::alignedSize(data[animOffset + 10 + j] * sizeof(byte *));
+		}
+	}
+	_spriteArena.reserve(arenaSize);
+
 	int talkingAnims = 0;
 	for (int i = 0; i < spriteCount; i++) {
 		uint32 animOffset = metadata_start + (i * 44);
@@ -1007,15 +1134,17 @@ Common::Array<Sprite> RoomManager::loadRoomAnimations(byte *pixelData, size_t pi
 			anim.movementFlags = data[subAnimOffset + 14 + (j * 2)] | (data[subAnimOffset + 14 + (j * 2) + 1] << 8);
 
 			uint32 totalBytesPerFrame = sprite.w * sprite.h * anim.nframes;
-			anim.animData = new byte *[anim.nframes];
+			anim.animData = _spriteArena.allocFrameTable(anim.nframes);
 			if (sprite.w > 0 && sprite.h > 0 && anim.nframes > 0) {
+				anim.hitMasks = new HitMask[anim.nframes];
+				anim.numHitMasks = anim.nframes;
 				for (int k = 0; k < anim.nframes; k++) {
 					if (picOffset >= pixelDataSize) {
 						debug("Pixel data offset out of bounds for sprite %d anim %d, offset %u, size %lu", i, j, picOffset, pixelDataSize);
 						break;
 					}
-					anim.animData[k] = new byte[sprite.w * sprite.h];
-					extractSingleFrame(pixelData + picOffset, anim.animData[k], k, sprite.w, sprite.h);
+					anim.animData[k] = frameAt(pixelData + picOffset, k, sprite.w, sprite.h);
+					anim.hitMasks[k].build(anim.animData[k], sprite.w, sprite.h);
 				}
 				sprite.animData[j] = anim;
 				picOffset += totalBytesPerFrame;
@@ -1038,19 +1167,11 @@ Common::Array<Sprite> RoomManager::loadRoomAnimations(byte *pixelData, size_t pi
 
 Common::Array<WalkBox> RoomManager::loadWalkboxes(byte *data, size_t size) {
 
-	int walkboxCountOffset = 0x213;
-	byte walkboxCount = data[walkboxCountOffset];
+	byte walkboxCount = data[kWalkboxCountOffset];
 
 	// debug("Walkbox count: %d", walkbox_count);
-	uint32 walkboxOffset = 0x218;
 	Common::Array<WalkBox> walkboxes;
 	for (int i = 0; i < walkboxCount; i++) {
-		uint32 boxOffset = walkboxOffset + i * 9;
-		int16 x1 = READ_LE_INT16(data + boxOffset);
-		int16 y1 = READ_LE_INT16(data + boxOffset + 2);
-		int16 w = READ_LE_INT16(data + boxOffset + 4);
-		int16 h = READ_LE_INT16(data + boxOffset + 6);
-		byte flags = data[boxOffset + 8];
 		WalkBox box;
 		box.index = i;
 		bool isChanged = false;
@@ -1066,11 +1187,7 @@ Common::Array<WalkBox> RoomManager::loadWalkboxes(byte *data, size_t size) {
 		}
 		if (isChanged)
 			continue;
-		box.x = x1;
-		box.y = y1;
-		box.w = w;
-		box.h = h;
-		box.flags = flags;
+		readWalkboxRecord(data, i, box);
 		walkboxes.push_back(box);
 	}
 
@@ -1135,11 +1252,13 @@ uint32 RoomManager::loadDescriptions(byte *pair12data, size_t pair12size, Common
 
 void RoomManager::loadConversationData(byte *pair12data, size_t pair12size, uint32 startPos, size_t &outConversationDataSize, byte *&outConversationData) {
 	size_t conversationStart = startPos;
-	outConversationDataSize = pair12size - conversationStart;
 	if (outConversationData != nullptr) {
 		delete[] outConversationData;
+		g_engine->_memStats.remove(kMemRoom, outConversationDataSize);
 	}
+	outConversationDataSize = pair12size - conversationStart;
 	outConversationData = new byte[outConversationDataSize];
+	g_engine->_memStats.add(kMemRoom, outConversationDataSize);
 	Common::copy(pair12data + conversationStart, pair12data + conversationStart + outConversationDataSize, outConversationData);
 	if (g_engine->_state->disabledBranches.contains(_currentRoomNumber)) {
 		applyDisabledChoices(_currentRoomNumber, outConversationData, outConversationDataSize);
@@ -1211,6 +1330,68 @@ void RoomManager::resetMetadataDefaults(byte room, byte *&data, size_t size) {
 	alfred8.close();
 }
 
+const Common::Array<byte> &RoomManager::getPristineMetadata(byte room) {
+	if (!_pristineMetadata.contains(room)) {
+		// Rooms not visited this session, e.g. changes loaded from a save
+		Common::File roomFile;
+		if (!roomFile.open(Common::Path("ALFRED.1"))) {
+			error("Could not open ALFRED.1");
+		}
+		roomFile.seek(room * kRoomStructSize + 10 * 8, SEEK_SET);
+		uint32 offset = roomFile.readUint32LE();
+		uint32 size = roomFile.readUint32LE();
+		Common::Array<byte> &data = _pristineMetadata[room];
+		data.resize(size);
+		roomFile.seek(offset, SEEK_SET);
+		roomFile.read(data.data(), size);
+		roomFile.close();
+		byte *ptr = data.data();
+		resetMetadataDefaults(room, ptr, size);
+	}
+	return _pristineMetadata[room];
+}
+
+void RoomManager::getDefaultHotspot(byte room, byte innerIndex, HotSpot &out) {
+	const Common::Array<byte> &data = getPristineMetadata(room);
+	out = HotSpot();
+	out.index = innerIndex;
+	out.innerIndex = innerIndex;
+	if ((uint)kHotspotCountOffset < data.size() && innerIndex < data[kHotspotCountOffset])
+		readHotspotRecord(data.data(), innerIndex, out);
+}
+
+void RoomManager::getDefaultWalkbox(byte room, byte index, WalkBox &out) {
+	const Common::Array<byte> &data = getPristineMetadata(room);
+	out = WalkBox();
+	out.index = index;
+	if ((uint)kWalkboxCountOffset < data.size() && index < data[kWalkboxCountOffset])
+		readWalkboxRecord(data.data(), index, out);
+}
+
+void RoomManager::readDefaultWalkboxes(Common::File &roomFile, byte room, Common::Array<WalkBox> &out) {
+	out.clear();
+	roomFile.seek(room * kRoomStructSize + 10 * 8, SEEK_SET);
+	uint32 offset = roomFile.readUint32LE();
+	uint32 size = roomFile.readUint32LE();
+	if (size <= (uint32)kWalkboxCountOffset)
+		return;
+	Common::Array<byte> data;
+	data.resize(size);
+	roomFile.seek(offset, SEEK_SET);
+	if (roomFile.read(data.data(), size) != size)
+		return;
+	// The walkboxes the game walks on, with the ALFRED.8 patches in
+	byte *ptr = data.data();
+	resetMetadataDefaults(room, ptr, size);
+	byte count = data[kWalkboxCountOffset];
+	for (int i = 0; i < count && kWalkboxDataOffset + (i + 1) * 9 <= (int)size; i++) {
+		WalkBox box;
+		box.index = i;
+		readWalkboxRecord(data.data(), i, box);
+		out.push_back(box);
+	}
+}
+
 void RoomManager::loadRoomTalkingAnimations(int roomNumber) {
 
 	int headerIndex = roomNumber;
@@ -1250,7 +1431,10 @@ void RoomManager::loadRoomTalkingAnimations(int roomNumber) {
 		return;
 	}
 
-	talkHeader.animA = new byte *[talkHeader.numFramesAnimA];
+	clearTalkingAnims();
+	_talkArena.reserve(FrameArena::alignedSize(talkHeader.numFramesAnimA * sizeof(byte *)) +
+					   FrameArena::alignedSize(talkHeader.numFramesAnimB * sizeof(byte *)));
+	talkHeader.animA = _talkArena.allocFrameTable(talkHeader.numFramesAnimA);
 
 	byte *data = nullptr;
 	int animASize = talkHeader.wAnimA * talkHeader.hAnimA * talkHeader.numFramesAnimA;
@@ -1260,25 +1444,26 @@ void RoomManager::loadRoomTalkingAnimations(int roomNumber) {
 	size_t decompressedSize = rleDecompress(data, dataSize, 0, dataSize, &decompressed);
 	free(data);
 	for (int i = 0; i < talkHeader.numFramesAnimA; i++) {
-		talkHeader.animA[i] = new byte[talkHeader.wAnimA * talkHeader.hAnimA];
-		extractSingleFrame(decompressed, talkHeader.animA[i], i, talkHeader.wAnimA, talkHeader.hAnimA);
+		talkHeader.animA[i] = frameAt(decompressed, i, talkHeader.wAnimA, talkHeader.hAnimA);
 	}
 
 	if (talkHeader.numFramesAnimB > 0) {
-		talkHeader.animB = new byte *[talkHeader.numFramesAnimB];
+		talkHeader.animB = _talkArena.allocFrameTable(talkHeader.numFramesAnimB);
 		for (int i = 0; i < talkHeader.numFramesAnimB; i++) {
-			talkHeader.animB[i] = new byte[talkHeader.wAnimB * talkHeader.hAnimB];
+			talkHeader.animB[i] = nullptr;
 			uint32 animBFrameOffset = animASize + (i * talkHeader.wAnimB * talkHeader.hAnimB);
 			if (animBFrameOffset + talkHeader.wAnimB * talkHeader.hAnimB >= decompressedSize) {
 				debug("Error: offset %d is beyond decompressed size %zu", animBFrameOffset, decompressedSize);
 				talkHeader.numFramesAnimB = 0;
 			} else {
-				extractSingleFrame(decompressed + animASize, talkHeader.animB[i], i, talkHeader.wAnimB, talkHeader.hAnimB);
+				talkHeader.animB[i] = frameAt(decompressed + animASize, i, talkHeader.wAnimB, talkHeader.hAnimB);
 			}
 		}
 	}
-	free(decompressed);
-	clearTalkingAnims();
+	// Talking frames point straight into the decompressed data
+	_talkingPixelData = decompressed;
+	_talkingPixelDataSize = decompressedSize;
+	g_engine->_memStats.add(kMemRoom, _talkingPixelDataSize);
 	_talkingAnims = talkHeader;
 
 	talkFile.close();
@@ -1321,6 +1506,9 @@ byte *RoomManager::loadShadowMap(int roomNumber) {
 	if (decompressedSize == 0) {
 		debug("Failed to decompress shadow map for room %d", roomNumber);
 		shadows = nullptr;
+	} else {
+		_shadowsSize = decompressedSize;
+		g_engine->_memStats.add(kMemRoom, _shadowsSize);
 	}
 	// debug("Decompressed shadow map for room %d, compressed size: %zu, decompressed size: %zu", roomNumber, compressedSize, decompressedSize);
 	free(compressed);
@@ -1328,6 +1516,13 @@ byte *RoomManager::loadShadowMap(int roomNumber) {
 	return shadows;
 }
 
+void RoomManager::clearShadowMap() {
+	free(_pixelsShadows);
+	_pixelsShadows = nullptr;
+	g_engine->_memStats.remove(kMemRoom, _shadowsSize);
+	_shadowsSize = 0;
+}
+
 void RoomManager::loadRemaps(int roomNumber) {
 
 	Common::File remapFile;
@@ -23,8 +23,11 @@
 
 #include "common/array.h"
 #include "common/file.h"
+#include "common/hashmap.h"
 #include "common/scummsys.h"
 
+#include "pelrock/arena.h"
+#include "pelrock/hitindex.h"
 #include "pelrock/types.h"
 
 namespace Pelrock {
@@ -49,7 +52,7 @@ static const int unpickableHotspotExtras[] = {
 	91, // mud and stone should only be picked under certain conditions!
 	92};
 
-static const uint32 stickerOffsets[137] = {
+static const uint32 stickerOffsets[kNumStickers] = {
 	0x000000, 0x00005B, 0x0000B6, 0x000298, 0x00047A, 0x0023C8, 0x004316, 0x004376,
 	0x005119, 0x005EBC, 0x0083ED, 0x008529, 0x0092C4, 0x00A3AA, 0x00B490, 0x00B6A6,
 	0x00C05A, 0x00CA0E, 0x00D3D0, 0x00D46E, 0x00F036, 0x00FB8F, 0x00FC55, 0x0119D7,
@@ -79,9 +82,19 @@ public:
 	RoomManager();
 	~RoomManager();
 	void clearTalkingAnims();
-	void clearAnims();
+	/** keepPixelData leaves the decompressed sprite sheets in place for a reload of the same room. */
+	void clearAnims(bool keepPixelData = false);
+	/** Room-lifetime storage for sprite frames; anything allocated here goes away on the next room load. */
+	FrameArena &getSpriteArena() { return _spriteArena; }
 	void clearRoomStickerPixels();
-	void loadRoomMetadata(Common::File *roomFile, int roomNumber);
+	/**
+	 * Loads everything the room needs besides background and palette. With reuseAssets the immutable
+	 * assets already decoded for this same room (sprite sheets, shadow map) are kept and only the
+	 * state-dependent data is rebuilt.
+	 */
+	void loadRoomMetadata(Common::File *roomFile, int roomNumber, bool reuseAssets = false);
+	/** Whether the given room is the one whose assets are currently loaded. */
+	bool isRoomLoaded(int roomNumber) const { return _roomLoaded && _currentRoomNumber == roomNumber; }
 	/**
 	 * Passer by animations are animations of characters that merely traverse the scene as ambient
 	 */
@@ -139,6 +152,15 @@ public:
 	void addWalkbox(WalkBox walkbox, int persist = PERSIST_BOTH);
 	void addWalkbox(byte room, WalkBox walkbox, int persist = PERSIST_BOTH);
 
+	/**
+	 * A hotspot or walkbox as the game data defines it, before any change made by play.
+	 * Indices past the room's records give default-constructed entries with just the index set.
+	 */
+	void getDefaultHotspot(byte room, byte innerIndex, HotSpot &out);
+	void getDefaultWalkbox(byte room, byte index, WalkBox &out);
+	/** Every walkbox of a room as the game loads it (ALFRED.8 patches applied), read from an open ALFRED.1 without caching. */
+	void readDefaultWalkboxes(Common::File &roomFile, byte room, Common::Array<WalkBox> &out);
+
 	void applyDisabledChoices(byte roomNumber, byte *conversationData, size_t conversationDataSize);
 	void applyDisabledChoice(ResetEntry entry, byte *conversationData, size_t conversationDataSize);
 	void addDisabledChoice(ChoiceOption choice);
@@ -162,6 +184,20 @@ public:
 	HotSpot *findHotspotByIndex(byte index);
 	HotSpot *findHotspotByExtra(uint16 extra);
 	PaletteAnim *getPaletteAnimForRoom(int roomNumber);
+	/**
+	 * Spatial index of the current room's hotspots, exits and walkboxes, rebuilt on demand after geometry changes.
+	 */
+	const HitIndex &getHitIndex();
+	byte findWalkboxAt(int x, int y);
+	/**
+	 * Bumped by every mutator that touches the current room, so callers can cache results derived from it.
+	 */
+	uint32 getMutationEpoch() const { return _mutationEpoch; }
+	/**
+	 * Indices into _currentRoomAnims in draw order (highest zOrder first). The sprite array itself is never
+	 * reordered, so Sprite pointers stay valid for as long as the room is loaded.
+	 */
+	const Common::Array<byte> &getDrawOrder();
 
 	byte _currentRoomNumber = 0;
 	int _prevRoomNumber = -1;
@@ -198,14 +234,31 @@ private:
 	void loadConversationData(byte *pair12data, size_t pair12size, uint32 startPos, size_t &outConversationDataSize, byte *&outConversationData);
 	void resetConversationStates(byte roomNumber, byte *conversationData, size_t conversationDataSize);
 	void resetMetadataDefaults(byte room, byte *&data, size_t size);
+	/** Pair 10 of the room with the ALFRED.8 defaults applied, read once and kept. */
+	const Common::Array<byte> &getPristineMetadata(byte room);
 
 	byte *loadShadowMap(int roomNumber);
+	void clearShadowMap();
+	/** Detaches the pixels of a loaded sticker so they can be kept across a reload, or nullptr. */
+	byte *takeStickerPixels(int stickerIndex);
 	void loadRemaps(int roomNumber);
 	Common::StringArray loadRoomNames();
 	byte loadMusicTrackForRoom(Common::File *roomFile, int roomOffset);
 	Common::Array<byte> loadRoomSfx(Common::File *roomFile, int roomOffset);
 
 	byte *_resetData = nullptr;
+	Common::HashMap<byte, Common::Array<byte>> _pristineMetadata;
+	FrameArena _spriteArena;
+	FrameArena _talkArena;
+	byte *_roomPixelData = nullptr;    // decompressed sprite sheets of the current room
+	byte *_talkingPixelData = nullptr; // decompressed talking animation sheets
+	uint32 _roomPixelDataSize = 0;
+	uint32 _talkingPixelDataSize = 0;
+	uint32 _shadowsSize = 0;
+	bool _roomLoaded = false;
+	HitIndex _hitIndex;
+	uint32 _mutationEpoch = 0;
+	Common::Array<byte> _drawOrder;
 };
 
 } // End of namespace Pelrock
@@ -18,7 +18,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
+#include "common/algorithm.h"
+#include "common/memstream.h"
 #include "common/savefile.h"
+#include "graphics/thumbnail.h"
 
 #include "pelrock.h"
 #include "pelrock/pelrock.h"
@@ -26,7 +29,10 @@
 
 namespace Pelrock {
 
-#define SAVEGAME_CURRENT_VERSION 1
+// 1: unversioned, fixed-width records. 2: header, bit-packed flags, varints, deltas against ALFRED.8
+#define SAVEGAME_CURRENT_VERSION 2
+
+static const uint32 kSaveMagic = MKTAG('P', 'S', 'A', 'V');
 
 // Helper functions for syncing structs
 void syncSticker(Common::Serializer &s, Sticker &sticker) {
@@ -344,6 +350,453 @@ Common::Error syncSaveData(Common::Serializer &s, SaveGameData *gameState) {
 	return Common::kNoError;
 }
 
+// Compact format (version 2)
+
+static void syncVarint(Common::Serializer &s, uint32 &value) {
+	if (s.isSaving()) {
+		uint32 v = value;
+		do {
+			byte b = v & 0x7F;
+			v >>= 7;
+			if (v)
+				b |= 0x80;
+			s.syncAsByte(b);
+		} while (v);
+	} else {
+		value = 0;
+		for (int shift = 0; shift < 35; shift += 7) {
+			byte b = 0;
+			s.syncAsByte(b);
+			value |= (uint32)(b & 0x7F) << shift;
+			if (!(b & 0x80))
+				break;
+		}
+	}
+}
+
+static void syncSignedVarint(Common::Serializer &s, int32 &value) {
+	// Zigzag, so small negative numbers stay short
+	uint32 encoded = ((uint32)value << 1) ^ (uint32)(value >> 31);
+	syncVarint(s, encoded);
+	value = (int32)(encoded >> 1) ^ -(int32)(encoded & 1);
+}
+
+template<typename T>
+static void syncDeltaField(Common::Serializer &s, T &field) {
+	int32 value = (int32)field;
+	syncSignedVarint(s, value);
+	field = (T)value;
+}
+
+static void syncCount(Common::Serializer &s, uint &count) {
+	uint32 value = count;
+	syncVarint(s, value);
+	count = value;
+}
+
+enum HotSpotDeltaBits {
+	kHotSpotDeltaIndex = 1 << 0,
+	kHotSpotDeltaInnerIndex = 1 << 1,
+	kHotSpotDeltaId = 1 << 2,
+	kHotSpotDeltaX = 1 << 3,
+	kHotSpotDeltaY = 1 << 4,
+	kHotSpotDeltaW = 1 << 5,
+	kHotSpotDeltaH = 1 << 6,
+	kHotSpotDeltaActionFlags = 1 << 7,
+	kHotSpotDeltaExtra = 1 << 8,
+	kHotSpotDeltaEnabled = 1 << 9,
+	kHotSpotDeltaSprite = 1 << 10,
+	kHotSpotDeltaZOrder = 1 << 11
+};
+
+/** Only the fields that differ from the game data's hotspot are stored. */
+static void syncHotSpotDelta(Common::Serializer &s, HotSpot &hotspot, const HotSpot &defaults) {
+	uint32 mask = 0;
+	if (s.isSaving()) {
+		mask |= hotspot.index != defaults.index ? kHotSpotDeltaIndex : 0;
+		mask |= hotspot.innerIndex != defaults.innerIndex ? kHotSpotDeltaInnerIndex : 0;
+		mask |= hotspot.id != defaults.id ? kHotSpotDeltaId : 0;
+		mask |= hotspot.x != defaults.x ? kHotSpotDeltaX : 0;
+		mask |= hotspot.y != defaults.y ? kHotSpotDeltaY : 0;
+		mask |= hotspot.w != defaults.w ? kHotSpotDeltaW : 0;
+		mask |= hotspot.h != defaults.h ? kHotSpotDeltaH : 0;
+		mask |= hotspot.actionFlags != defaults.actionFlags ? kHotSpotDeltaActionFlags : 0;
+		mask |= hotspot.extra != defaults.extra ? kHotSpotDeltaExtra : 0;
+		mask |= hotspot.isEnabled != defaults.isEnabled ? kHotSpotDeltaEnabled : 0;
+		mask |= hotspot.isSprite != defaults.isSprite ? kHotSpotDeltaSprite : 0;
+		mask |= hotspot.zOrder != defaults.zOrder ? kHotSpotDeltaZOrder : 0;
+	} else {
+		hotspot = defaults;
+	}
+	syncVarint(s, mask);
+	if (mask & kHotSpotDeltaIndex)
+		syncDeltaField(s, hotspot.index);
+	if (mask & kHotSpotDeltaInnerIndex)
+		syncDeltaField(s, hotspot.innerIndex);
+	if (mask & kHotSpotDeltaId)
+		syncDeltaField(s, hotspot.id);
+	if (mask & kHotSpotDeltaX)
+		syncDeltaField(s, hotspot.x);
+	if (mask & kHotSpotDeltaY)
+		syncDeltaField(s, hotspot.y);
+	if (mask & kHotSpotDeltaW)
+		syncDeltaField(s, hotspot.w);
+	if (mask & kHotSpotDeltaH)
+		syncDeltaField(s, hotspot.h);
+	if (mask & kHotSpotDeltaActionFlags)
+		syncDeltaField(s, hotspot.actionFlags);
+	if (mask & kHotSpotDeltaExtra)
+		syncDeltaField(s, hotspot.extra);
+	if (mask & kHotSpotDeltaEnabled)
+		syncDeltaField(s, hotspot.isEnabled);
+	if (mask & kHotSpotDeltaSprite)
+		syncDeltaField(s, hotspot.isSprite);
+	if (mask & kHotSpotDeltaZOrder)
+		syncDeltaField(s, hotspot.zOrder);
+}
+
+enum WalkBoxDeltaBits {
+	kWalkBoxDeltaIndex = 1 << 0,
+	kWalkBoxDeltaX = 1 << 1,
+	kWalkBoxDeltaY = 1 << 2,
+	kWalkBoxDeltaW = 1 << 3,
+	kWalkBoxDeltaH = 1 << 4,
+	kWalkBoxDeltaFlags = 1 << 5
+};
+
+static void syncWalkBoxDelta(Common::Serializer &s, WalkBox &walkbox, const WalkBox &defaults) {
+	uint32 mask = 0;
+	if (s.isSaving()) {
+		mask |= walkbox.index != defaults.index ? kWalkBoxDeltaIndex : 0;
+		mask |= walkbox.x != defaults.x ? kWalkBoxDeltaX : 0;
+		mask |= walkbox.y != defaults.y ? kWalkBoxDeltaY : 0;
+		mask |= walkbox.w != defaults.w ? kWalkBoxDeltaW : 0;
+		mask |= walkbox.h != defaults.h ? kWalkBoxDeltaH : 0;
+		mask |= walkbox.flags != defaults.flags ? kWalkBoxDeltaFlags : 0;
+	} else {
+		walkbox = defaults;
+	}
+	syncVarint(s, mask);
+	if (mask & kWalkBoxDeltaIndex)
+		syncDeltaField(s, walkbox.index);
+	if (mask & kWalkBoxDeltaX)
+		syncDeltaField(s, walkbox.x);
+	if (mask & kWalkBoxDeltaY)
+		syncDeltaField(s, walkbox.y);
+	if (mask & kWalkBoxDeltaW)
+		syncDeltaField(s, walkbox.w);
+	if (mask & kWalkBoxDeltaH)
+		syncDeltaField(s, walkbox.h);
+	if (mask & kWalkBoxDeltaFlags)
+		syncDeltaField(s, walkbox.flags);
+}
+
+/**
+ * Flags are nearly all booleans: one bit each for the ones set to 1, then index/value pairs
+ * for the few that hold anything else.
+ */
+static void syncPackedFlags(Common::Serializer &s, GameStateData *gameState) {
+	byte bits[(kNumGameFlags + 7) / 8];
+	memset(bits, 0, sizeof(bits));
+	uint numOther = 0;
+	if (s.isSaving()) {
+		for (int i = 0; i < kNumGameFlags; i++) {
+			if (gameState->flags[i] == 1)
+				bits[i >> 3] |= 1 << (i & 7);
+			else if (gameState->flags[i] != 0)
+				numOther++;
+		}
+	}
+	s.syncBytes(bits, sizeof(bits));
+	syncCount(s, numOther);
+	if (s.isSaving()) {
+		for (int i = 0; i < kNumGameFlags; i++) {
+			if (gameState->flags[i] > 1) {
+				uint32 index = i;
+				syncVarint(s, index);
+				s.syncAsByte(gameState->flags[i]);
+			}
+		}
+	} else {
+		for (int i = 0; i < kNumGameFlags; i++) {
+			gameState->flags[i] = (bits[i >> 3] >> (i & 7)) & 1;
+		}
+		for (uint i = 0; i < numOther; i++) {
+			uint32 index = 0;
+			byte value = 0;
+			syncVarint(s, index);
+			s.syncAsByte(value);
+			gameState->setFlag(index, value);
+		}
+	}
+}
+
+/** Conversation roots default to 0xFF: a presence bit per room, then the values that are set. */
+static void syncConversationRoots(Common::Serializer &s, GameStateData *gameState) {
+	byte bits[112 / 8];
+	memset(bits, 0, sizeof(bits));
+	if (s.isSaving()) {
+		for (int i = 0; i < 112; i++) {
+			if (gameState->conversationCurrentRoot[i] != 0xFF)
+				bits[i >> 3] |= 1 << (i & 7);
+		}
+	}
+	s.syncBytes(bits, sizeof(bits));
+	for (int i = 0; i < 112; i++) {
+		if (bits[i >> 3] & (1 << (i & 7)))
+			s.syncAsByte(gameState->conversationCurrentRoot[i]);
+		else if (s.isLoading())
+			gameState->conversationCurrentRoot[i] = 0xFF;
+	}
+}
+
+enum RoomSectionBits {
+	kRoomSectionStickers = 1 << 0,
+	kRoomSectionExits = 1 << 1,
+	kRoomSectionWalkBoxes = 1 << 2,
+	kRoomSectionHotSpots = 1 << 3,
+	kRoomSectionSprites = 1 << 4,
+	kRoomSectionBranches = 1 << 5
+};
+
+static const byte kBranchDisabledMarker = 0xFA;
+
+static void syncRoomSection(Common::Serializer &s, GameStateData *gameState, byte room, byte sections) {
+	if (sections & kRoomSectionStickers) {
+		Common::Array<Sticker> &stickers = gameState->stickersPerRoom[room];
+		uint count = stickers.size();
+		syncCount(s, count);
+		for (uint i = 0; i < count; i++) {
+			uint32 stickerIndex = s.isSaving() ? stickers[i].stickerIndex : 0;
+			syncVarint(s, stickerIndex);
+			if (s.isLoading())
+				stickers.push_back(g_engine->_res->getSticker(stickerIndex));
+		}
+	}
+	if (sections & kRoomSectionExits) {
+		Common::Array<ExitChange> &exits = gameState->roomExitChanges[room];
+		uint count = exits.size();
+		syncCount(s, count);
+		for (uint i = 0; i < count; i++) {
+			uint32 packed = s.isSaving() ? (exits[i].exitIndex << 1) | (exits[i].enabled ? 1 : 0) : 0;
+			syncVarint(s, packed);
+			if (s.isLoading())
+				exits.push_back({room, (byte)(packed >> 1), (packed & 1) != 0});
+		}
+	}
+	if (sections & kRoomSectionWalkBoxes) {
+		Common::Array<WalkBoxChange> &walkboxes = gameState->roomWalkBoxChanges[room];
+		uint count = walkboxes.size();
+		syncCount(s, count);
+		if (s.isLoading())
+			walkboxes.resize(count);
+		for (uint i = 0; i < count; i++) {
+			WalkBoxChange &change = walkboxes[i];
+			change.roomNumber = room;
+			s.syncAsByte(change.walkboxIndex);
+			WalkBox defaults;
+			g_engine->_room->getDefaultWalkbox(room, change.walkboxIndex, defaults);
+			syncWalkBoxDelta(s, change.walkbox, defaults);
+		}
+	}
+	if (sections & kRoomSectionHotSpots) {
+		Common::Array<HotSpotChange> &hotspots = gameState->roomHotSpotChanges[room];
+		uint count = hotspots.size();
+		syncCount(s, count);
+		if (s.isLoading())
+			hotspots.resize(count);
+		for (uint i = 0; i < count; i++) {
+			HotSpotChange &change = hotspots[i];
+			change.roomNumber = room;
+			s.syncAsByte(change.hotspotIndex);
+			HotSpot defaults;
+			g_engine->_room->getDefaultHotspot(room, change.hotspotIndex, defaults);
+			syncHotSpotDelta(s, change.hotspot, defaults);
+		}
+	}
+	if (sections & kRoomSectionSprites) {
+		Common::Array<SpriteChange> &sprites = gameState->spriteChanges[room];
+		uint count = sprites.size();
+		syncCount(s, count);
+		if (s.isLoading())
+			sprites.resize(count);
+		for (uint i = 0; i < count; i++) {
+			sprites[i].roomNumber = room;
+			s.syncAsByte(sprites[i].spriteIndex);
+			s.syncAsByte(sprites[i].zIndex);
+		}
+	}
+	if (sections & kRoomSectionBranches) {
+		Common::Array<ResetEntry> &branches = gameState->disabledBranches[room];
+		uint count = branches.size();
+		syncCount(s, count);
+		if (s.isLoading())
+			branches.resize(count);
+		int32 prevOffset = 0;
+		for (uint i = 0; i < count; i++) {
+			ResetEntry &entry = branches[i];
+			entry.room = room;
+			int32 offsetDelta = (int32)entry.offset - prevOffset;
+			syncSignedVarint(s, offsetDelta);
+			entry.offset = prevOffset + offsetDelta;
+			prevOffset = entry.offset;
+			// Almost every patch is the single disabled-choice marker, which then costs no data bytes
+			uint32 header = 0;
+			if (s.isSaving()) {
+				bool isMarker = entry.dataSize == 1 && entry.data[0] == kBranchDisabledMarker;
+				header = (entry.dataSize << 1) | (isMarker ? 1 : 0);
+			}
+			syncVarint(s, header);
+			if (s.isLoading()) {
+				entry.dataSize = header >> 1;
+				entry.data = new byte[entry.dataSize];
+				if (header & 1) {
+					entry.data[0] = kBranchDisabledMarker;
+					continue;
+				}
+			} else if (header & 1) {
+				continue;
+			}
+			s.syncBytes(entry.data, entry.dataSize);
+		}
+	}
+}
+
+static byte roomSections(const GameStateData *gameState, byte room) {
+	byte sections = 0;
+	sections |= gameState->stickersPerRoom.contains(room) ? kRoomSectionStickers : 0;
+	sections |= gameState->roomExitChanges.contains(room) ? kRoomSectionExits : 0;
+	sections |= gameState->roomWalkBoxChanges.contains(room) ? kRoomSectionWalkBoxes : 0;
+	sections |= gameState->roomHotSpotChanges.contains(room) ? kRoomSectionHotSpots : 0;
+	sections |= gameState->spriteChanges.contains(room) ? kRoomSectionSprites : 0;
+	sections |= gameState->disabledBranches.contains(room) ? kRoomSectionBranches : 0;
+	return sections;
+}
+
+template<typename T>
+static void collectRooms(const Common::HashMap<byte, T> &map, Common::Array<byte> &rooms) {
+	for (const auto &pair : map) {
+		if (Common::find(rooms.begin(), rooms.end(), pair._key) == rooms.end())
+			rooms.push_back(pair._key);
+	}
+}
+
+static bool syncCompactGameStateData(Common::Serializer &s, GameStateData *gameState) {
+	uint32 stateGame = gameState->stateGame;
+	syncVarint(s, stateGame);
+	gameState->stateGame = (GameState)stateGame;
+
+	syncPackedFlags(s, gameState);
+
+	uint inventorySize = gameState->inventoryItems.size();
+	syncCount(s, inventorySize);
+	if (s.isLoading())
+		gameState->inventoryItems.resize(inventorySize);
+	s.syncBytes(gameState->inventoryItems.data(), inventorySize);
+	syncDeltaField(s, gameState->selectedInventoryItem);
+
+	syncConversationRoots(s, gameState);
+
+	// Everything that play changes in a room, grouped per room
+	Common::Array<byte> rooms;
+	if (s.isSaving()) {
+		collectRooms(gameState->stickersPerRoom, rooms);
+		collectRooms(gameState->roomExitChanges, rooms);
+		collectRooms(gameState->roomWalkBoxChanges, rooms);
+		collectRooms(gameState->roomHotSpotChanges, rooms);
+		collectRooms(gameState->spriteChanges, rooms);
+		collectRooms(gameState->disabledBranches, rooms);
+		Common::sort(rooms.begin(), rooms.end());
+	} else {
+		gameState->stickersPerRoom.clear();
+		gameState->roomExitChanges.clear();
+		gameState->roomWalkBoxChanges.clear();
+		gameState->roomHotSpotChanges.clear();
+		gameState->spriteChanges.clear();
+		gameState->clearBranches();
+	}
+	uint numRooms = rooms.size();
+	syncCount(s, numRooms);
+	for (uint i = 0; i < numRooms && !s.err(); i++) {
+		byte room = s.isSaving() ? rooms[i] : 0;
+		byte sections = s.isSaving() ? roomSections(gameState, room) : 0;
+		s.syncAsByte(room);
+		s.syncAsByte(sections);
+		syncRoomSection(s, gameState, room, sections);
+	}
+	return !s.err();
+}
+
+static Common::Error syncCompactSaveData(Common::Serializer &s, SaveGameData *game) {
+	s.syncAsByte(game->currentRoom);
+	syncDeltaField(s, game->alfredX);
+	syncDeltaField(s, game->alfredY);
+	s.syncAsByte((byte &)game->alfredDir);
+
+	if (s.err() || !syncCompactGameStateData(s, game->gameState))
+		return Common::Error(Common::kUnknownError, "Failed to sync game state data.");
+
+	return Common::kNoError;
+}
+
+Common::Error PelrockEngine::saveGameStream(Common::WriteStream *stream, bool isAutosave) {
+	stream->writeUint32BE(kSaveMagic);
+	stream->writeByte(SAVEGAME_CURRENT_VERSION);
+	Common::Serializer s(nullptr, stream);
+	s.setVersion(SAVEGAME_CURRENT_VERSION);
+	return syncGame(s);
+}
+
+Common::Error PelrockEngine::loadGameStream(Common::SeekableReadStream *stream) {
+	// Version 1 saves have no header and start straight with the room number
+	uint32 version = 1;
+	int64 start = stream->pos();
+	if (stream->readUint32BE() == kSaveMagic) {
+		version = stream->readByte();
+		if (version > SAVEGAME_CURRENT_VERSION)
+			return Common::Error(Common::kUnknownError, Common::String::format("Unsupported save version %u", version));
+	} else {
+		stream->seek(start, SEEK_SET);
+	}
+	Common::Serializer s(stream, nullptr);
+	s.setVersion(version);
+	return syncGame(s);
+}
+
+Common::Error PelrockEngine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
+	if (!isAutosave) {
+		// A late autosave must not land on top of this save, or race it for the thumbnail
+		_autosaveWriter.flush();
+		Common::Error result = Engine::saveGameState(slot, desc, isAutosave);
+		if (result.getCode() == Common::kNoError)
+			_saveSlots.setSlot(slot, desc);
+		return result;
+	}
+
+	// Snapshot on the game thread: the serialised state and the screen; the writer does the rest
+	Common::MemoryWriteStreamDynamic *data = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+	Common::Error result = saveGameStream(data, true);
+	if (result.getCode() != Common::kNoError) {
+		delete data;
+		return result;
+	}
+	Graphics::Surface *thumb = new Graphics::Surface();
+	Graphics::createThumbnail(*thumb);
+	// The slot cache takes the save in once the writer has it on disk
+	if (!_autosaveWriter.submit(slot, getSaveStateName(slot), desc, getTotalPlayTime() / 1000, data, thumb))
+		return Common::Error(Common::kUnknownError, "The previous autosave is still being written");
+	return Common::kNoError;
+}
+
+Common::Error PelrockEngine::loadGameState(int slot) {
+	_autosaveWriter.flush();
+	Common::Error result = Engine::loadGameState(slot);
+	// A save the cache does not know about was put there behind our back, pick it up
+	if (result.getCode() == Common::kNoError && !_saveSlots.isUsed(slot))
+		_saveSlots.refreshSlot(slot);
+	return result;
+}
+
 Common::Error PelrockEngine::syncGame(Common::Serializer &s) {
 	Common::Error result;
 
@@ -352,11 +805,14 @@ Common::Error PelrockEngine::syncGame(Common::Serializer &s) {
 		if (saveGame.gameState != nullptr)
 			delete saveGame.gameState;
 		saveGame.gameState = new GameStateData();
-		result = syncSaveData(s, &(saveGame));
+		if (s.getVersion() >= 2)
+			result = syncCompactSaveData(s, &saveGame);
+		else
+			result = syncSaveData(s, &(saveGame));
 		loadGame(saveGame);
 	} else {
 		SaveGameData *saveGame = createSaveGameData();
-		result = syncSaveData(s, saveGame);
+		result = syncCompactSaveData(s, saveGame);
 		delete saveGame;
 	}
 	return result;
@@ -369,10 +825,38 @@ void PelrockEngine::loadGame(SaveGameData &saveGame) {
 	delete _state;
 	_state = saveGame.gameState;
 
-	setScreenAndPrepare(saveGame.currentRoom, _alfredState.direction);
+	// Loading a save of the room on screen keeps its decoded assets and only reapplies the state
+	setScreenAndPrepare(saveGame.currentRoom, _alfredState.direction, true);
 	_state->stateGame = GAME;
 }
 
+bool PelrockEngine::takeSnapshot() {
+	Common::MemoryWriteStreamDynamic data(DisposeAfterUse::YES);
+	if (saveGameStream(&data).getCode() != Common::kNoError)
+		return false;
+	return _snapshots.push(_room->_currentRoomNumber, getTotalPlayTime(), data.getData(), data.size());
+}
+
+bool PelrockEngine::restoreSnapshot(uint age) {
+	Common::Array<byte> data;
+	if (!_snapshots.reconstruct(age, data))
+		return false;
+	Common::MemoryReadStream stream(data.data(), data.size());
+	Common::Error result = loadGameStream(&stream);
+	if (result.getCode() != Common::kNoError) {
+		warning("Could not restore snapshot %u: %s", _snapshots.get(age).id, result.getDesc().c_str());
+		return false;
+	}
+	setTotalPlayTime(_snapshots.get(age).playTime);
+	return true;
+}
+
+bool PelrockEngine::rewindSnapshot() {
+	if (_snapshots.size() > 1)
+		_snapshots.dropNewest();
+	return restoreSnapshot(0);
+}
+
 SaveGameData *PelrockEngine::createSaveGameData() const {
 	SaveGameData *saveGame = new SaveGameData();
 	saveGame->currentRoom = _room->_currentRoomNumber;
@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/config-manager.h"
+#include "engines/metaengine.h"
+
+#include "pelrock/pelrock.h"
+#include "pelrock/saveslots.h"
+
+namespace Pelrock {
+
+void SaveSlotCache::ensureLoaded() {
+	if (!_loaded) {
+		_loaded = true;
+		// An autosave half written by the timer thread must not be listed
+		g_engine->_autosaveWriter.flush();
+		SaveStateList saves = g_engine->getMetaEngine()->listSaves(ConfMan.getActiveDomainName().c_str());
+		for (const SaveStateDescriptor &desc : saves) {
+			int slot = desc.getSaveSlot();
+			if (isValid(slot)) {
+				_slots[slot].desc = desc.getDescription();
+				_slots[slot].used = true;
+			}
+		}
+	}
+	takeWrittenAutosaves();
+}
+
+void SaveSlotCache::takeWrittenAutosaves() {
+	int slot;
+	Common::String desc;
+	while (g_engine->_autosaveWriter.takeWritten(slot, desc)) {
+		if (isValid(slot)) {
+			_slots[slot].desc = desc;
+			_slots[slot].used = true;
+		}
+	}
+}
+
+const Common::String &SaveSlotCache::getDescription(int slot) {
+	static const Common::String empty;
+	if (!isValid(slot))
+		return empty;
+	ensureLoaded();
+	return _slots[slot].desc;
+}
+
+bool SaveSlotCache::isUsed(int slot) {
+	if (!isValid(slot))
+		return false;
+	ensureLoaded();
+	return _slots[slot].used;
+}
+
+void SaveSlotCache::setSlot(int slot, const Common::String &desc) {
+	if (!isValid(slot))
+		return;
+	ensureLoaded();
+	Entry &entry = _slots[slot];
+	entry.desc = desc;
+	entry.used = true;
+}
+
+void SaveSlotCache::removeSlot(int slot) {
+	if (!isValid(slot))
+		return;
+	// Or a finished autosave still waiting to be taken in brings it back
+	takeWrittenAutosaves();
+	Entry &entry = _slots[slot];
+	entry.desc.clear();
+	entry.used = false;
+}
+
+void SaveSlotCache::refreshSlot(int slot) {
+	if (!isValid(slot))
+		return;
+	if (!_loaded) {
+		// The full listing will pick it up
+		return;
+	}
+	g_engine->_autosaveWriter.flush();
+	SaveStateDescriptor desc = g_engine->getMetaEngine()->querySaveMetaInfos(ConfMan.getActiveDomainName().c_str(), slot);
+	if (desc.getSaveSlot() == slot)
+		setSlot(slot, desc.getDescription());
+	else
+		removeSlot(slot);
+}
+
+} // End of namespace Pelrock
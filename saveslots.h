@@ -0,0 +1,66 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_SAVESLOTS_H
+#define PELROCK_SAVESLOTS_H
+
+#include "common/scummsys.h"
+#include "common/str.h"
+
+namespace Pelrock {
+
+static const int kNumSaveSlots = 256;
+
+/**
+ * What the original save/load screens need to know about each slot.
+ * The save files are listed once per session; after that the engine keeps the cache in step
+ * as it saves, loads and deletes, so opening the menu never goes back to the disk.
+ * Autosaves are picked up once the writer reports them on disk.
+ */
+class SaveSlotCache {
+public:
+	~SaveSlotCache();
+
+	const Common::String &getDescription(int slot);
+	bool isUsed(int slot);
+
+	void setSlot(int slot, const Common::String &desc);
+	void removeSlot(int slot);
+	/** Reads the header of a single slot again. */
+	void refreshSlot(int slot);
+
+private:
+	struct Entry {
+		Common::String desc;
+		bool used = false;
+	};
+
+	/** Lists the saves on first use, then takes in the autosaves written since the last query. */
+	void ensureLoaded();
+	void takeWrittenAutosaves();
+	static bool isValid(int slot) { return slot >= 0 && slot < kNumSaveSlots; }
+
+	Entry _slots[kNumSaveSlots];
+	bool _loaded = false;
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_SAVESLOTS_H
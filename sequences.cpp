@@ -0,0 +1,854 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/file.h"
+#include "graphics/cursorman.h"
+#include "graphics/paletteman.h"
+
+#include "pelrock/offsets.h"
+#include "pelrock/pelrock.h"
+#include "pelrock/util.h"
+
+namespace Pelrock {
+
+/** Cutscenes that load another room from one of their steps and carry on there. */
+static bool keepsOnRoomChange(SequenceId id) {
+	return id == kSequenceSwimmingPool || id == kSequenceCredits;
+}
+
+void PelrockEngine::startSequence(SequenceId id, bool blocksInput) {
+	if (isSequenceRunning(id))
+		return;
+	Sequence seq;
+	seq.id = id;
+	seq.blocksInput = blocksInput;
+	seq.keepOnRoomChange = keepsOnRoomChange(id);
+	_sequences.push_back(seq);
+}
+
+bool PelrockEngine::isSequenceRunning(SequenceId id) const {
+	for (uint i = 0; i < _sequences.size(); i++) {
+		if (_sequences[i].id == id)
+			return true;
+	}
+	return false;
+}
+
+bool PelrockEngine::isInputBlockedBySequence() const {
+	for (uint i = 0; i < _sequences.size(); i++) {
+		if (_sequences[i].blocksInput)
+			return true;
+	}
+	return false;
+}
+
+void PelrockEngine::stopSequences() {
+	for (uint i = 0; i < _sequences.size();) {
+		// A room change made by a cutscene's own step doesn't end that cutscene
+		if (_updatingSequences && _sequences[i].keepOnRoomChange)
+			i++;
+		else
+			_sequences.remove_at(i);
+	}
+	// A room loaded from outside, e.g. a restored game, takes down what a cutscene had on screen
+	if (!_updatingSequences && (_cutscene.extraScreen || _cutscene.creditsPage.getPixels()))
+		hideExtraScreen();
+}
+
+void PelrockEngine::updateSequences() {
+	// Steps never block, but a step that changes room runs the new room's extra actions, which may
+	// still pump frames
+	if (_updatingSequences)
+		return;
+	_updatingSequences = true;
+	for (uint i = 0; i < _sequences.size();) {
+		Sequence &seq = _sequences[i];
+		bool ready = true;
+		switch (seq.wait) {
+		case kSequenceWaitTicks:
+			ready = --seq.ticksLeft <= 0;
+			break;
+		case kSequenceWaitSpecialAnim:
+			ready = _res->_isSpecialAnimFinished;
+			break;
+		case kSequenceWaitDialogue:
+			ready = !_dialog->isSceneDialogueActive();
+			break;
+		case kSequenceWaitAction:
+			ready = !_queuedAction.isQueued && !_queuedAction.readyToExecute &&
+					!_dialog->_dialogActive && !_dialog->_conversationActive;
+			break;
+		case kSequenceWaitWalk:
+			ready = _alfredState.animState != ALFRED_WALKING;
+			break;
+		case kSequenceWaitSmoke:
+			ready = !_smokeState.isActive;
+			break;
+		default:
+			break;
+		}
+		if (!ready) {
+			i++;
+			continue;
+		}
+
+		// Work on a copy: the step may start or stop sequences, which moves the array around
+		Sequence current = seq;
+		current.wait = kSequenceWaitNone;
+		bool running = runSequenceStep(current);
+		// Ids are unique; find it again, as the step may have added or removed others
+		int at = -1;
+		for (uint j = 0; j < _sequences.size(); j++) {
+			if (_sequences[j].id == current.id) {
+				at = j;
+				break;
+			}
+		}
+		if (at < 0) {
+			// Stopped from inside the step, e.g. by a room change
+			break;
+		}
+		if (running) {
+			_sequences[at] = current;
+			i = at + 1;
+		} else {
+			_sequences.remove_at(at);
+			i = at;
+		}
+	}
+	_updatingSequences = false;
+}
+
+/**
+ * Runs the current step of a sequence. Returns false once the sequence is over.
+ */
+bool PelrockEngine::runSequenceStep(Sequence &seq) {
+	switch (seq.id) {
+	case kSequenceDogPee:
+		return dogPeeStep(seq);
+	case kSequenceSorcererAppears:
+		return sorcererAppearsStep(seq);
+	case kSequenceSorcererSpell:
+		return sorcererSpellStep(seq);
+	case kSequenceBrickWindow:
+		return brickWindowStep(seq);
+	case kSequenceSwimmingPool:
+		return swimmingPoolStep(seq);
+	case kSequenceTravelToEgypt:
+		return travelToEgyptStep(seq);
+	case kSequencePyramidCollapse:
+		return pyramidCollapseStep(seq);
+	case kSequenceEnding:
+		return endingStep(seq);
+	case kSequenceCredits:
+		return creditsStep(seq);
+	default:
+		return false;
+	}
+}
+
+/**
+ * Dog in room 19 pees next to Alfred, who complains and steps away.
+ */
+bool PelrockEngine::dogPeeStep(Sequence &seq) {
+	Sprite *dog = _room->findSpriteByIndex(2);
+	switch (seq.step) {
+	case 0:
+		dog->animData[0].nframes = 24;
+		seq.step = 1;
+		seq.waitTicks(1);
+		return true;
+	case 1:
+		if (dog->animData[0].curFrame < 23) {
+			seq.waitTicks(1);
+			return true;
+		}
+		dog->animData[0].nframes = 9;
+		dog->animData[0].curFrame = 0;
+
+		_dialog->sayInScene(_res->_ingameTexts[kTextQueAscoCasiMeMea]);
+		seq.step = 2;
+		seq.waitFor(kSequenceWaitDialogue);
+		return true;
+	case 2:
+		_currentHotspot = nullptr; // Clear so arrival direction isn't overridden by dog hotspot
+		walkTo(152, _alfredState.y);
+		seq.step = 3;
+		seq.waitFor(kSequenceWaitWalk);
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool PelrockEngine::sorcererAppearsStep(Sequence &seq) {
+	if (seq.step == 0) {
+		_sound->playSound(_room->_roomSfx[0]);
+		_room->findSpriteByIndex(_fightSorcererSpriteIdx)->animData[0].nframes = 1;
+		startSmokeAnimation(_fightSorcererSpriteIdx, false);
+		seq.step = 1;
+		seq.waitFor(kSequenceWaitSmoke);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * The sorcerer casts his spell and Alfred is sent back to room 49.
+ */
+bool PelrockEngine::sorcererSpellStep(Sequence &seq) {
+	int idx = _room->_currentRoomNumber - 51;
+	Sprite *sorcerer = _room->findSpriteByIndex(_fightSorcererSpriteIdx);
+	switch (seq.step) {
+	case 0:
+		sorcerer->animData[0].nframes = kFightRooms[idx].spellFrames;
+		sorcerer->animData[0].speed = 1;
+		_sound->playSound(_room->_roomSfx[1]);
+		seq.step = 1;
+		seq.waitTicks(kFightRooms[idx].spellFrames);
+		return true;
+	case 1:
+		sorcerer->animData[0].nframes = 1;
+		startSmokeAnimation(-1, true);
+		seq.step = 2;
+		seq.waitFor(kSequenceWaitSmoke);
+		return true;
+	case 2:
+		_alfredState.x = 294;
+		_alfredState.y = 387;
+		_alfredState.direction = ALFRED_UP;
+		setScreenAndPrepare(49, ALFRED_UP);
+		return false;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Alfred throws the brick through the shop window in room 3; the people inside react and he
+ * walks off.
+ */
+bool PelrockEngine::brickWindowStep(Sequence &seq) {
+	Sprite *brick = _room->findSpriteByIndex(7);
+	switch (seq.step) {
+	case 0:
+		startAlfredSpecialAnim(4);
+		seq.step = 1;
+		seq.waitFor(kSequenceWaitSpecialAnim);
+		return true;
+	case 1:
+		brick->x = 420;
+		brick->y = 241;
+		brick->zOrder = 10;
+		seq.step = 2;
+		seq.waitTicks(1);
+		return true;
+	case 2:
+		// The brick flies up until it reaches the window
+		brick->y -= 10;
+		if (brick->y > 70) {
+			seq.waitTicks(1);
+			return true;
+		}
+		brick->zOrder = 255;
+		debug("Brick hit the window");
+		_room->addSticker(11);
+		_sound->playSound(_room->_roomSfx[2]); // Play glass breaking sound
+
+		// Remove brick from inventory
+		_state->removeInventoryItem(4);
+
+		// Put at the very edge of the screen so it gets adjusted
+		_dialog->sayInScene(_res->_ingameTexts[kTextQueHaSidoEso], 639, brickWindowDialogueY(0));
+		seq.step = 3;
+		seq.waitFor(kSequenceWaitDialogue);
+		return true;
+	case 3:
+		_dialog->sayInScene(_res->_ingameTexts[kTextQuienAndaAhi], 639, brickWindowDialogueY(1));
+		seq.step = 4;
+		seq.waitFor(kSequenceWaitDialogue);
+		return true;
+	case 4:
+		_dialog->sayInScene(_res->_ingameTexts[kTextYoMeVoy]);
+		seq.step = 5;
+		seq.waitFor(kSequenceWaitDialogue);
+		return true;
+	case 5:
+		_state->setFlag(FLAG_STONE_THROWN, true);
+		_state->setFlag(FLAG_OPEN_SHOP, true);
+		_room->addStickerToRoom(_room->_currentRoomNumber, 9, PERSIST_PERM);
+		_room->addStickerToRoom(_room->_currentRoomNumber, 10, PERSIST_PERM);
+		_room->disableHotspot(_room->findHotspotByExtra(295));
+		_room->disableHotspot(_room->findHotspotByExtra(294)); // Disable window hotspot
+		_room->enableSprite(5, 100, PERSIST_PERM);             // Enable fake teeth sprite
+		_disableAction = true;                                 // Prevent player from doing anything until the action is done
+		walkTo(630, _alfredState.y);
+		return false;
+	default:
+		return false;
+	}
+}
+
+/** The two lines from inside the shop sit under the window, one below the other. */
+int16 PelrockEngine::brickWindowDialogueY(int line) {
+	int16 y = _room->findHotspotByExtra(294)->y + 22;
+	return line == 0 ? y : y + 10 + _largeFont->getFontHeight();
+}
+
+bool PelrockEngine::fadeOutStep(Sequence &seq, int stepSize) {
+	// Palette animations keep writing their colours while the room runs, so stop after a full fade
+	bool done = _graphics->fadeToBlackStep(stepSize) || ++seq.counter * stepSize >= 255;
+	if (done)
+		seq.counter = 0;
+	return done;
+}
+
+/**
+ * Naked girls swim underwater, guard enters the scene.
+ * "diving" animation is stored in Alfred.7 as a single RLE chunk with multiple continuous sprite sizes.
+ */
+bool PelrockEngine::swimmingPoolStep(Sequence &seq) {
+	struct SwimmerInfo {
+		int spriteIndex;
+		int16 x;
+		int16 y;
+		int w;
+		int h;
+		int nFrames;
+		uint16 movementFlags;
+	};
+
+	static const SwimmerInfo swimmers[4] = {
+		{3, 3, -17, 93, 88, 9, 0x02FF}, // Move right and up
+		{4, 1, 0, 68, 31, 7, 0},
+		{5, -14, -18, 79, 95, 9, 0},
+		{6, -1, -8, 54, 42, 8, 0}};
+
+	Sprite *guard = _room->findSpriteByIndex(0);
+	switch (seq.step) {
+	case 0: {
+		byte *buffer = nullptr;
+		size_t bufSize = 0;
+		_res->loadOtherSpecialAnim(1446862, true, buffer, bufSize);
+
+		int acc = 0;
+		for (int i = 0; i < 4; i++) {
+			Sprite *sprite = _room->findSpriteByIndex(swimmers[i].spriteIndex);
+			sprite->x = sprite->x + swimmers[i].x;
+			sprite->y = sprite->y + swimmers[i].y;
+			sprite->w = swimmers[i].w;
+			sprite->h = swimmers[i].h;
+			sprite->animData[0].nframes = swimmers[i].nFrames;
+			sprite->animData[0].movementFlags = swimmers[i].movementFlags;
+			sprite->animData[0].curFrame = 0;
+			sprite->animData[0].loopCount = 0;
+			sprite->animData[0].curLoop = 0;
+			sprite->animData[0].speed = 0;
+			sprite->animData[0].elpapsedFrames = 0;
+			sprite->disableAfterSequence = true;
+
+			// The old frames stay in the room arena until the next room load
+			FrameArena &arena = _room->getSpriteArena();
+			sprite->animData[0].animData = arena.allocFrameTable(sprite->animData[0].nframes);
+			for (int j = 0; j < sprite->animData[0].nframes; j++) {
+				sprite->animData[0].animData[j] = arena.alloc(sprite->w * sprite->h);
+				extractSingleFrame(buffer + acc, sprite->animData[0].animData[j], j, sprite->w, sprite->h);
+			}
+			buildAnimHitMasks(sprite->animData[0], sprite->w, sprite->h);
+			acc += sprite->w * sprite->h * sprite->animData[0].nframes;
+		}
+		free(buffer);
+
+		_sound->stopMusic();
+		_sound->playMusicTrack(28);
+		seq.step = 1;
+		seq.waitTicks(1);
+		return true;
+	}
+	case 1:
+		// The first swimmer is disabled once the dive is over
+		if (_room->findSpriteByIndex(swimmers[0].spriteIndex)->zOrder != 255) {
+			seq.waitTicks(1);
+			return true;
+		}
+		_state->setFlag(FLAG_EUNUCH_APPEARS, true);
+		guard->animData[0].movementFlags = 0x14;
+		seq.step = 2;
+		seq.waitTicks(1);
+		return true;
+	case 2:
+		if (guard->x > _alfredState.x + 70) {
+			seq.waitTicks(1);
+			return true;
+		}
+		guard->animData[0].movementFlags = 0;
+		guard->animData[0].curFrame = 0;
+		guard->animData[0].nframes = 1;
+		// copy idle frame from talking animation
+		setAnimFrame(guard->animData[0], 0, _room->_talkingAnims.animA[0], guard->w, guard->h);
+		_alfredState.direction = ALFRED_RIGHT;
+		startWalkAndAction(_room->findHotspotByExtra(guard->extra), TALK);
+		seq.step = 3;
+		seq.waitFor(kSequenceWaitAction);
+		return true;
+	case 3:
+		if (!fadeOutStep(seq, 10)) {
+			seq.waitTicks(1);
+			return true;
+		}
+		_alfredState.x = 271;
+		_alfredState.y = 385;
+		setScreenAndPrepare(40, ALFRED_UP);
+		_state->setFlag(FLAG_PHARAOH_VIEWING, true);
+		startWalkAndAction(_room->findHotspotByExtra(640), TALK);
+		seq.step = 4;
+		seq.waitFor(kSequenceWaitAction);
+		return true;
+	case 4:
+		if (!fadeOutStep(seq, 10)) {
+			seq.waitTicks(1);
+			return true;
+		}
+		_alfredState.x = 271;
+		_alfredState.y = 385;
+		_state->setFlag(FLAG_TO_WORK, true);
+		setScreenAndPrepare(41, ALFRED_UP);
+		return false;
+	default:
+		return false;
+	}
+}
+
+/**
+ * The trip to Egypt: once the travel agent's conversation is over the room fades out and an extra
+ * screen traces the route on the map in red, then Alfred arrives in room 21.
+ */
+bool PelrockEngine::travelToEgyptStep(Sequence &seq) {
+	static const int kRouteColors = 96;
+	switch (seq.step) {
+	case 0:
+		seq.step = 1;
+		seq.waitFor(kSequenceWaitAction);
+		return true;
+	case 1:
+		if (!fadeOutStep(seq, 10)) {
+			seq.waitTicks(1);
+			return true;
+		}
+		_sound->playMusicTrack(26, false);
+		showExtraScreen(6);
+		seq.step = 2;
+		seq.waitTicks(2);
+		return true;
+	case 2: {
+		int index = (160 + seq.counter) * 3;
+		_cutscene.palette[index] = 255;   // Red
+		_cutscene.palette[index + 1] = 0; // Green
+		_cutscene.palette[index + 2] = 0; // Blue
+		g_system->getPaletteManager()->setPalette(_cutscene.palette, 0, 256);
+		if (++seq.counter < kRouteColors) {
+			seq.waitTicks(2);
+			return true;
+		}
+		hideExtraScreen();
+
+		_alfredState.x = 575;
+		_alfredState.y = 210;
+		setScreenAndPrepare(21, ALFRED_DOWN);
+
+		// Original gives 4 items after room load (items 17, 64, 24, 59)
+		_state->inventoryItems.clear();
+		_state->selectedInventoryItem = -1;
+		// we dont want a flashing animation in this case! calling state->addInventory directly
+		_state->addInventoryItem(17);
+		_state->addInventoryItem(64);
+		_state->addInventoryItem(24);
+		_state->addInventoryItem(59);
+		return false;
+	}
+	default:
+		return false;
+	}
+}
+
+/**
+ * The pyramid in room 36 collapses; the guard climbs out, complains and Alfred leaves for room 21.
+ */
+bool PelrockEngine::pyramidCollapseStep(Sequence &seq) {
+	Sprite *npc = _room->findSpriteByIndex(0);
+	Sprite *collapseSprite = _room->findSpriteByIndex(2);
+	switch (seq.step) {
+	case 0:
+		// Hide NPC initially and start the collapse animation
+		npc->zOrder = 255;
+		collapseSprite->zOrder = 254;
+		_sound->playSound("QUAKE1ZZ.SMP", 0);
+		seq.step = 1;
+		seq.waitTicks(1);
+		return true;
+	case 1: {
+		// Wait for collapse animation frame 5
+		if (collapseSprite->animData[collapseSprite->curAnimIndex].curFrame < 5) {
+			seq.waitTicks(1);
+			return true;
+		}
+		collapseSprite->zOrder = 255;
+
+		// Background tile copies to have collapsed pyramid stick
+		// copy 99×45 from secondary buffer to front buffer
+		static const int srcX = 240, srcY = 145;
+		static const int copyW = 99, copyH = 45;
+		Common::Rect copyRect(srcX, srcY, srcX + copyW, srcY + copyH);
+		_currentBackground.blitFrom(_compositeBuffer, copyRect, Common::Point(srcX, srcY));
+		_backgroundModified = true;
+
+		_dialog->sayInScene(_res->_ingameTexts[kTextYaNoSeHaceOnComoAntes]);
+		seq.step = 2;
+		seq.waitFor(kSequenceWaitDialogue);
+		return true;
+	}
+	case 2:
+		npc->zOrder = 254;
+		npc->animData[0].nframes = 5;
+		npc->animData[npc->curAnimIndex].movementFlags = 0x1C;
+		npc->y -= 25; // One-time nudge upward to emerge from behind pyramid
+		seq.step = 3;
+		seq.waitTicks(1);
+		return true;
+	case 3:
+		if (npc->x < 339) {
+			seq.waitTicks(1);
+			return true;
+		}
+		npc->animData[npc->curAnimIndex].movementFlags = 0x340;
+		seq.step = 4;
+		seq.waitTicks(1);
+		return true;
+	case 4:
+		if (npc->y < 206) {
+			seq.waitTicks(1);
+			return true;
+		}
+		npc->animData[npc->curAnimIndex].movementFlags = 0x14;
+		seq.step = 5;
+		seq.waitTicks(1);
+		return true;
+	case 5:
+		if (npc->x > 307) {
+			seq.waitTicks(1);
+			return true;
+		}
+		// Stop NPC movement
+		npc->animData[0].nframes = 1;
+		npc->animData[npc->curAnimIndex].movementFlags = 0;
+		_dialog->sayInScene(_res->_ingameTexts[kTextPor5Minutos], (byte)0);
+		seq.step = 6;
+		seq.waitFor(kSequenceWaitDialogue);
+		return true;
+	case 6: {
+		_room->disableExit(36, 0);
+
+		_room->addStickerToRoom(21, 79);
+		_room->disableExit(21, 2, PERSIST_BOTH);
+		HotSpot *pyramidHotspot = new HotSpot();
+		pyramidHotspot->x = 510;
+		pyramidHotspot->y = 33;
+		pyramidHotspot->w = 99;
+		pyramidHotspot->h = 45;
+		pyramidHotspot->extra = 411;
+		pyramidHotspot->isEnabled = false;
+		pyramidHotspot->innerIndex = 2;
+		pyramidHotspot->index = 7;
+		_room->disableHotspot(21, pyramidHotspot, PERSIST_BOTH);
+
+		_dialog->sayInScene(_res->_ingameTexts[kTextTaLuegoLucas]);
+		seq.step = 7;
+		seq.waitFor(kSequenceWaitDialogue);
+		return true;
+	}
+	case 7:
+		// Walk Alfred to right edge exit -> room 21
+		_alfredState.direction = ALFRED_RIGHT;
+		walkTo(603, 212);
+		seq.step = 8;
+		seq.waitFor(kSequenceWaitWalk);
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Final screen with Alfred and the princess, shown until a key is pressed; the credits follow.
+ */
+bool PelrockEngine::endingStep(Sequence &seq) {
+	switch (seq.step) {
+	case 0:
+		showExtraScreen(14);
+		loadEndingSprites();
+		_sound->playMusicTrack(3);
+		// Runs until a key is pressed, as the original does
+		_events->_lastKeyEvent = Common::KEYCODE_INVALID;
+		seq.step = 1;
+		seq.waitTicks(1);
+		return true;
+	case 1:
+		// Title text visible frames 21–149 (original: frame > 0x14 && frame < 0x96)
+		seq.counter++;
+		_cutscene.showTitle = seq.counter > 20 && seq.counter < 150;
+		if (_events->_lastKeyEvent == Common::KEYCODE_INVALID) {
+			seq.waitTicks(1);
+			return true;
+		}
+		_events->_lastKeyEvent = Common::KEYCODE_INVALID;
+		hideExtraScreen();
+		startSequence(kSequenceCredits);
+		return false;
+	default:
+		return false;
+	}
+}
+
+/**
+ * 25-page room slideshow: each page loads a game room and overlays credit texts. It loops until a
+ * key is pressed, which quits the game.
+ */
+bool PelrockEngine::creditsStep(Sequence &seq) {
+	static const int kNumCreditPages = 25;
+	static const int kFramesPerPage = 45;
+	switch (seq.step) {
+	case 0: {
+		_sound->playMusicTrack(3);
+		_cutscene.creditTexts = _res->getCredits();
+		_cutscene.creditSpeakers.clear();
+		// Preprocess credit texts: extract speaker IDs and apply word wrapping
+		for (uint i = 0; i < _cutscene.creditTexts.size(); i++) {
+			Common::StringArray &texts = _cutscene.creditTexts[i];
+			byte speakerId;
+			_dialog->processColorAndTrim(texts, speakerId);
+			_cutscene.creditSpeakers.push_back(speakerId);
+			// Text is already encoded for new lines but should also be wrapped to respect the max chars per line!
+			texts = _dialog->wordWrap(texts)[0];
+			// all lines start with a space but the first one contains the trailing space of the speakerId
+			texts[0] = texts[0].substr(1, texts[0].size() - 1);
+		}
+
+		CursorMan.showMouse(false);
+		_alfredState.setState(ALFRED_SKIP_DRAWING);
+		_disableAmbientSounds = true;
+		_disableAction = true;
+		_cutscene.creditsPageIndex = 0;
+		seq.step = 1;
+		return creditsStep(seq);
+	}
+	case 1:
+		showCreditsPage(_cutscene.creditsPageIndex);
+		_events->_lastKeyEvent = Common::KEYCODE_INVALID;
+		seq.counter = 0;
+		seq.step = 2;
+		seq.waitTicks(1);
+		return true;
+	case 2:
+		if (_events->_lastKeyEvent != Common::KEYCODE_INVALID) {
+			// Any key press exits credits
+			_cutscene.creditsPage.free();
+			quitGame();
+			return false;
+		}
+		if (++seq.counter < kFramesPerPage) {
+			seq.waitTicks(1);
+			return true;
+		}
+		// After the last page the slideshow starts over
+		_cutscene.creditsPageIndex = (_cutscene.creditsPageIndex + 1) % kNumCreditPages;
+		seq.step = 1;
+		return creditsStep(seq);
+	default:
+		return false;
+	}
+}
+
+void PelrockEngine::showCreditsPage(int page) {
+	static const int kCreditRooms[] = {
+		22, 27, 36, 23, 24, 37, 25, 26, 49, 43, 35, 52, 29,
+		39, 40, 41, 45, 47, 21, 50, 46, 42, 34, 30, 14};
+
+	// loads screen
+	setScreen(kCreditRooms[page]);
+	if (kCreditRooms[page] == 24) {
+		Sprite *pigeons = _room->findSpriteByIndex(1);
+		pigeons->disableAfterSequence = true;
+	}
+
+	const Common::StringArray &texts = _cutscene.creditTexts[page];
+	int height = texts.size() * 25; // Add some padding
+
+	Graphics::Surface &s = _cutscene.creditsPage;
+	s.free();
+	s.create(640, height + 1, Graphics::PixelFormat::createFormatCLUT8());
+	s.fillRect(s.getRect(), 255); // Clear surface
+
+	int maxWidth = 0;
+	/**
+	 * Last line is less indented for some reason, so skip that for calculation
+	 */
+	for (uint i = 0; i < texts.size(); i++) {
+		maxWidth = MAX(maxWidth, _largeFont->getStringWidth(texts[i]));
+	}
+
+	int startX = 320 - (maxWidth / 2);
+	_cutscene.creditsPageY = (400 - s.getRect().height()) / 2 - 10;
+
+	for (uint i = 0; i < texts.size(); i++) {
+		// subtract that extra negative identation
+		int xPos = i == texts.size() - 1 ? startX - 10 : startX;
+		int yPos = i * 25; // Above sprite, adjust for line
+		_largeFont->drawString(&s, texts[i], xPos, yPos, 640, _cutscene.creditSpeakers[page], Graphics::kTextAlignLeft);
+	}
+}
+
+void PelrockEngine::showExtraScreen(int screenIndex) {
+	if (!_cutscene.palette)
+		_cutscene.palette = new byte[768];
+	if (!_bgScreen.getPixels()) {
+		_bgScreen.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
+	}
+	_res->getExtraScreen(screenIndex, (byte *)_bgScreen.getPixels(), _cutscene.palette);
+	CursorMan.showMouse(false);
+	_graphics->clearScreen();
+	g_system->getPaletteManager()->setPalette(_cutscene.palette, 0, 256);
+	_cutscene.extraScreen = true;
+}
+
+void PelrockEngine::hideExtraScreen() {
+	_graphics->clearScreen();
+	g_system->getPaletteManager()->setPalette(_room->_roomPalette, 0, 256);
+	_bgScreen.free();
+	CursorMan.showMouse(true);
+	freeCutsceneAssets();
+	_cutscene.extraScreen = false;
+	_cutscene.showTitle = false;
+	_screen->markAllDirty();
+}
+
+void PelrockEngine::freeCutsceneAssets() {
+	delete[] _cutscene.palette;
+	_cutscene.palette = nullptr;
+	for (Sprite *sprite : _cutscene.sprites) {
+		for (int i = 0; i < sprite->numAnims; i++) {
+			Anim &anim = sprite->animData[i];
+			for (int j = 0; j < anim.nframes; j++)
+				delete[] anim.animData[j];
+			delete[] anim.animData;
+		}
+		delete[] sprite->animData;
+		delete sprite;
+	}
+	_cutscene.sprites.clear();
+	_cutscene.creditsPage.free();
+}
+
+void PelrockEngine::loadEndingSprites() {
+	Common::File alfred7;
+	if (!alfred7.open(Common::Path("ALFRED.7"))) {
+		error("Could not open ALFRED.7");
+		return;
+	}
+	byte *decompressedBuf = nullptr;
+	size_t decompressedSize = 0;
+	rleDecompressSingleBuda(&alfred7, 3222250, decompressedBuf, decompressedSize);
+	alfred7.close();
+
+	int animValues[4][8] = {
+		{426, 211, 114, 189, 2, 2, 0, 0}, // Legs anim values (2 frames)
+		{287, 68, 42, 26, 3, 1, 1, 15},   // Eyes anim values (3 frames)
+		{172, 173, 93, 71, 3, 1, 3, 17},  // Alfred hand anim values (3 frames)
+		{241, 334, 55, 66, 2, 2, 0, 0}    // Hand anim values (2 frames)
+	};
+
+	uint32 pos = 0;
+	for (int i = 0; i < 4; i++) {
+		Sprite *sprite = new Sprite();
+		sprite->x = animValues[i][0];
+		sprite->y = animValues[i][1];
+		sprite->w = animValues[i][2];
+		sprite->h = animValues[i][3];
+		sprite->stride = animValues[i][2] * animValues[i][3];
+		bool isIdleAnim = animValues[i][7] > 0;
+		if (isIdleAnim) {
+			sprite->numAnims = 2;
+		} else {
+			sprite->numAnims = 1;
+		}
+
+		sprite->animData = new Anim[sprite->numAnims];
+		Anim mainAnim;
+		mainAnim.nframes = animValues[i][4];
+		mainAnim.loopCount = animValues[i][6];
+		mainAnim.speed = animValues[i][5];
+
+		byte *legsAnimData = decompressedBuf + pos;
+		mainAnim.animData = new byte *[mainAnim.nframes];
+		for (int j = 0; j < mainAnim.nframes; j++) {
+			mainAnim.animData[j] = new byte[sprite->stride];
+			extractSingleFrame(legsAnimData, mainAnim.animData[j], j, sprite->w, sprite->h);
+		}
+
+		if (isIdleAnim) {
+			Anim idleAnim;
+			idleAnim.nframes = 1;
+			idleAnim.loopCount = 1;
+			idleAnim.speed = animValues[i][7];
+			idleAnim.animData = new byte *[1];
+			idleAnim.animData[0] = new byte[sprite->stride];
+			extractSingleFrame(legsAnimData, idleAnim.animData[0], 0, sprite->w, sprite->h);
+			sprite->animData[0] = idleAnim;
+			sprite->animData[1] = mainAnim;
+		} else {
+			sprite->animData[0] = mainAnim;
+		}
+
+		pos += sprite->stride * mainAnim.nframes;
+		_cutscene.sprites.push_back(sprite);
+	}
+	free(decompressedBuf);
+}
+
+void PelrockEngine::drawExtraScreen() {
+	_compositeBuffer.blitFrom(_bgScreen);
+	for (Sprite *sprite : _cutscene.sprites) {
+		drawNextFrame(sprite);
+	}
+	if (_cutscene.showTitle) {
+		Common::Rect bbox = _largeFont->getBoundingBox("ALFRED PELROCK");
+		int y1 = 400 / 2 - bbox.height() / 2;
+		int y2 = 400 / 2 + bbox.height() / 2;
+		_largeFont->drawString(&_compositeBuffer, "ALFRED PELROCK", 0, y1, 640, 255, Graphics::kTextAlignCenter);
+		_largeFont->drawString(&_compositeBuffer, "En busca de un sue\x80o", 0, y2, 640, 255, Graphics::kTextAlignCenter);
+	}
+}
+
+void PelrockEngine::drawCutsceneOverlays() {
+	if (_cutscene.creditsPage.getPixels()) {
+		_compositeBuffer.transBlitFrom(_cutscene.creditsPage, _cutscene.creditsPage.getRect(), Common::Point(0, _cutscene.creditsPageY), 255);
+	}
+}
+
+} // End of namespace Pelrock
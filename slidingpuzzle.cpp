@@ -185,7 +185,7 @@ void SlidingPuzzle::shuffleLoop() {
 			_events->_lastKeyEvent = Common::KEYCODE_INVALID;
 			break;
 		}
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 }
 
@@ -213,7 +213,7 @@ void SlidingPuzzle::puzzleLoop() {
 		_events->_lastKeyEvent = Common::KEYCODE_INVALID;
 
 		present();
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 }
 
@@ -245,7 +245,7 @@ bool SlidingPuzzle::handleClick(int screenX, int screenY) {
 		_sound->playSound("CHIQUITO.WAV", 3);
 		while (!g_engine->shouldQuit() && _sound->isPlaying(3)) {
 			_events->pollEvent();
-			g_system->delayMillis(10);
+			g_engine->_chrono->idle();
 		}
 		_sound->stopSound(3);
 		return true;
@@ -273,7 +273,7 @@ void SlidingPuzzle::showOriginalImage() {
 		_events->pollEvent();
 		if (_events->_isKeydown == false)
 			break;
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 }
 
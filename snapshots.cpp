@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "pelrock/snapshots.h"
+#include "pelrock/pelrock.h"
+
+namespace Pelrock {
+
+SnapshotRing::~SnapshotRing() {
+	clear();
+}
+
+void SnapshotRing::store(StateSnapshot &entry, Common::Array<byte> &data) {
+	release(entry);
+	entry.data.swap(data);
+	_storedBytes += entry.data.size();
+	g_engine->_memStats.add(kMemSnapshots, entry.data.size());
+}
+
+void SnapshotRing::release(StateSnapshot &entry) {
+	_storedBytes -= entry.data.size();
+	g_engine->_memStats.remove(kMemSnapshots, entry.data.size());
+	entry.data.clear();
+}
+
+bool SnapshotRing::push(byte room, uint32 playTime, const byte *data, uint32 size) {
+	if (!_entries.empty()) {
+		StateSnapshot &newest = _entries.back();
+		const byte *old = newest.data.data();
+		uint32 oldSize = newest.size;
+		if (oldSize == size && !memcmp(old, data, size))
+			return false;
+
+		// Turn the current newest into a delta against the new state
+		uint32 common = MIN(oldSize, size);
+		uint32 prefix = 0;
+		while (prefix < common && old[prefix] == data[prefix])
+			prefix++;
+		uint32 suffix = 0;
+		while (suffix < common - prefix && old[oldSize - 1 - suffix] == data[size - 1 - suffix])
+			suffix++;
+		Common::Array<byte> middle(old + prefix, oldSize - prefix - suffix);
+		newest.prefix = prefix;
+		newest.suffix = suffix;
+		store(newest, middle);
+	}
+
+	if (_entries.size() >= _capacity) {
+		release(_entries[0]);
+		_entries.remove_at(0);
+	}
+
+	StateSnapshot entry;
+	entry.id = _nextId++;
+	entry.room = room;
+	entry.playTime = playTime;
+	entry.size = size;
+	_entries.push_back(entry);
+	Common::Array<byte> full(data, size);
+	store(_entries.back(), full);
+	return true;
+}
+
+bool SnapshotRing::reconstruct(uint age, Common::Array<byte> &out) const {
+	if (age >= _entries.size())
+		return false;
+	out = _entries.back().data;
+	for (uint i = 1; i <= age; i++) {
+		const StateSnapshot &entry = get(i);
+		Common::Array<byte> older;
+		older.reserve(entry.size);
+		for (uint32 j = 0; j < entry.prefix; j++)
+			older.push_back(out[j]);
+		for (uint32 j = 0; j < entry.data.size(); j++)
+			older.push_back(entry.data[j]);
+		for (uint32 j = out.size() - entry.suffix; j < out.size(); j++)
+			older.push_back(out[j]);
+		out.swap(older);
+	}
+	return true;
+}
+
+void SnapshotRing::dropNewest() {
+	if (_entries.empty())
+		return;
+	if (_entries.size() > 1) {
+		// The next one is only a delta against the newest, make it whole before letting go
+		Common::Array<byte> full;
+		reconstruct(1, full);
+		StateSnapshot &next = _entries[_entries.size() - 2];
+		next.prefix = 0;
+		next.suffix = 0;
+		store(next, full);
+	}
+	release(_entries.back());
+	_entries.pop_back();
+}
+
+void SnapshotRing::clear() {
+	for (uint i = 0; i < _entries.size(); i++)
+		release(_entries[i]);
+	_entries.clear();
+}
+
+} // End of namespace Pelrock
@@ -0,0 +1,80 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PELROCK_SNAPSHOTS_H
+#define PELROCK_SNAPSHOTS_H
+
+#include "common/array.h"
+#include "common/scummsys.h"
+
+namespace Pelrock {
+
+static const uint kDefaultSnapshotCount = 32;
+
+struct StateSnapshot {
+	uint32 id = 0;
+	byte room = 0;
+	uint32 playTime = 0; // milliseconds
+	uint32 size = 0;     // size of the save data it stands for
+	/**
+	 * The newest snapshot holds the whole save. Every older one holds only the bytes that differ
+	 * from its newer neighbour: that neighbour's first `prefix` and last `suffix` bytes, with `data` in between.
+	 */
+	uint32 prefix = 0;
+	uint32 suffix = 0;
+	Common::Array<byte> data;
+};
+
+/**
+ * Ring of in-memory game states, in the compact save format, for quick-save, quick-load and rewind.
+ * Older entries are stored as reverse deltas against the next newer one, so dropping the oldest
+ * never invalidates anything and a few dozen snapshots take a few kilobytes.
+ */
+class SnapshotRing {
+public:
+	explicit SnapshotRing(uint capacity = kDefaultSnapshotCount) : _capacity(capacity) {}
+	~SnapshotRing();
+
+	/** Adds a snapshot as the newest one. Returns false if it is identical to the current newest. */
+	bool push(byte room, uint32 playTime, const byte *data, uint32 size);
+	/** Rebuilds the save data of the snapshot `age` steps back from the newest. */
+	bool reconstruct(uint age, Common::Array<byte> &out) const;
+	/** Forgets the newest snapshot; the one before it becomes the newest. */
+	void dropNewest();
+	void clear();
+
+	uint size() const { return _entries.size(); }
+	/** age 0 is the newest. */
+	const StateSnapshot &get(uint age) const { return _entries[_entries.size() - 1 - age]; }
+	uint32 getStoredBytes() const { return _storedBytes; }
+
+private:
+	void store(StateSnapshot &entry, Common::Array<byte> &data);
+	void release(StateSnapshot &entry);
+
+	Common::Array<StateSnapshot> _entries; // oldest first
+	uint _capacity;
+	uint32 _nextId = 1;
+	uint32 _storedBytes = 0;
+};
+
+} // End of namespace Pelrock
+
+#endif // PELROCK_SNAPSHOTS_H
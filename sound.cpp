@@ -140,10 +140,10 @@ const char *SOUND_FILENAMES[] = {
 };
 
 SoundManager::SoundManager(Audio::Mixer *mixer)
-	: _mixer(mixer), _currentVolume(128) {
+	: _mixer(mixer), _currentVolume(128), _ambientRandom("PelrockAmbient"), _localMusic(mixer) {
 	// TODO: Initialize sound manager
 	g_system->getAudioCDManager()->open();
-	memset(_sfxSoundIndex, 0xFF, sizeof(_sfxSoundIndex));
+	memset(_indexChannels, 0, sizeof(_indexChannels));
 }
 
 SoundManager::~SoundManager() {
@@ -151,13 +151,11 @@ SoundManager::~SoundManager() {
 	stopMusic();
 }
 
-void SoundManager::playSound(byte index, int channel, int loopCount) {
+void SoundManager::playSound(byte index, int channel, int loopCount, SoundCategory category) {
 	// debug("Playing sound index %d (%s)", index, SOUND_FILENAMES[index]);
 	auto it = _soundMap.find(SOUND_FILENAMES[index]);
 	if (it != _soundMap.end()) {
-		int usedChannel = playSound(it->_value, channel, loopCount);
-		if (usedChannel >= 0 && usedChannel < kMaxChannels)
-			_sfxSoundIndex[usedChannel] = index;
+		playSound(it->_value, index, channel, loopCount, category);
 	} else {
 		debug("Sound file %s not found in sound map", SOUND_FILENAMES[index]);
 	}
@@ -166,57 +164,184 @@ void SoundManager::playSound(byte index, int channel, int loopCount) {
 void SoundManager::playSound(const char *filename, int channel, int loopCount) {
 	auto it = _soundMap.find(filename);
 	if (it != _soundMap.end()) {
-		playSound(it->_value, channel, loopCount);
+		playSound(it->_value, 0xFF, channel, loopCount, kSoundScripted);
 	} else {
 		debug("Sound file %s not found in sound map", filename);
 	}
 }
 
-int SoundManager::playSound(SonidoFile sound, int channel, int loopCount) {
+/**
+ * One sample of SONIDOS.DAT read straight from the shared file handle.
+ * Streams are read on the mixer thread, so the handle is positioned and read under a lock.
+ * Reads are reported to the sound manager, if given one, lock wait included.
+ */
+class SampleReadStream : public Common::SeekableReadStream {
+public:
+	SampleReadStream(Common::File *file, Common::Mutex *mutex, uint32 begin, uint32 size, SoundManager *stats = nullptr)
+		: _file(file), _mutex(mutex), _begin(begin), _size(size), _stats(stats) {}
+
+	bool eos() const override { return _eos; }
+	void clearErr() override {
+		_eos = false;
+		Common::SeekableReadStream::clearErr();
+	}
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		if (whence == SEEK_CUR)
+			offset += _pos;
+		else if (whence == SEEK_END)
+			offset += _size;
+		_pos = (uint32)CLIP<int64>(offset, 0, _size);
+		_eos = false;
+		return true;
+	}
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		if (dataSize > _size - _pos) {
+			dataSize = _size - _pos;
+			_eos = true;
+		}
+		if (dataSize == 0)
+			return 0;
+		uint32 start = g_system->getMillis();
+		uint32 bytesRead;
+		{
+			Common::StackLock lock(*_mutex);
+			_file->seek(_begin + _pos, SEEK_SET);
+			bytesRead = _file->read(dataPtr, dataSize);
+		}
+		_pos += bytesRead;
+		if (_stats)
+			_stats->recordStreamRead(bytesRead, g_system->getMillis() - start);
+		return bytesRead;
+	}
+
+private:
+	Common::File *_file;
+	Common::Mutex *_mutex;
+	uint32 _begin;
+	uint32 _size;
+	SoundManager *_stats;
+	uint32 _pos = 0;
+	bool _eos = false;
+};
+
+void SoundManager::parseSampleHeader(SonidoFile &sound) {
+	byte header[80];
+	uint32 headerRead = MIN<uint32>(sound.size, sizeof(header));
+	_sonidosFile.seek(sound.offset, SEEK_SET);
+	if (_sonidosFile.read(header, headerRead) != headerRead)
+		return;
+	// detectFormat only looks at the first bytes and the total size
+	sound.format = detectFormat(header, sound.size);
+	if (headerRead >= 0x20)
+		sound.sampleRate = getSampleRate(header, sound.format);
+
+	switch (sound.format) {
+	case SOUND_FORMAT_RAWPCM:
+	case SOUND_FORMAT_MILES:
+	case SOUND_FORMAT_MILES2: {
+		uint32 headerSize = sound.format == SOUND_FORMAT_RAWPCM ? 0 : 80;
+		if (sound.size <= headerSize)
+			break;
+		// 8-bit unsigned mono
+		sound.rawFlags = Audio::FLAG_UNSIGNED;
+		sound.pcmOffset = headerSize;
+		sound.pcmSize = sound.size - headerSize;
+		sound.streamable = true;
+		break;
+	}
+	case SOUND_FORMAT_RIFF: {
+		// Plain PCM wave data can be streamed the same way; anything else goes through the wave decoder
+		SampleReadStream sample(&_sonidosFile, &_sonidosMutex, sound.offset, sound.size);
+		int size, rate;
+		byte flags;
+		uint16 wavType;
+		if (Audio::loadWAVFromStream(sample, size, rate, flags, &wavType) && wavType == 1 && size > 0) {
+			sound.sampleRate = rate;
+			sound.rawFlags = flags;
+			sound.pcmOffset = sample.pos();
+			sound.pcmSize = MIN<uint32>(size, sound.size - sound.pcmOffset);
+			sound.streamable = true;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+Audio::SeekableAudioStream *SoundManager::loadSampleIntoMemory(const SonidoFile &sound) {
+	// Own handle: the shared one may be in use by the mixer thread
 	Common::File sonidosFile;
 	if (!sonidosFile.open(Common::Path("SONIDOS.DAT"))) {
 		debug("Failed to open SONIDOS.DAT");
-		return -1;
+		return nullptr;
 	}
-
 	sonidosFile.seek(sound.offset, SEEK_SET);
 	byte *data = (byte *)malloc(sound.size);
 	sonidosFile.read(data, sound.size);
 	sonidosFile.close();
+	// The stream frees the buffer
+	g_engine->_memStats.handOff(kMemSound, sound.size);
+	Common::MemoryReadStream *memStream = new Common::MemoryReadStream(data, sound.size, DisposeAfterUse::YES);
+	return Audio::makeWAVStream(memStream, DisposeAfterUse::YES);
+}
 
-	SoundFormat format = detectFormat(data, sound.size);
-	uint32 sampleRate = getSampleRate(data, format);
-	Audio::SeekableAudioStream *stream = nullptr;
-
-	if (format == SOUND_FORMAT_RIFF) {
-		// For WAV/RIFF files, use the wave decoder
-		Common::MemoryReadStream *memStream = new Common::MemoryReadStream(data, sound.size, DisposeAfterUse::YES);
-		stream = Audio::makeWAVStream(memStream, DisposeAfterUse::YES);
-		// no need to free 'data' here, it will be freed when memStream is disposed
-	} else if (format == SOUND_FORMAT_RAWPCM || format == SOUND_FORMAT_MILES || format == SOUND_FORMAT_MILES2) {
-		// Determine the offset to skip the header
-		uint32 headerSize = 0;
-		if (format == SOUND_FORMAT_MILES || format == SOUND_FORMAT_MILES2) {
-			headerSize = 80;
+/**
+ * Passes a sound through to the mixer and reports how long after the trigger it was first read.
+ */
+class LatencyProbeStream : public Audio::AudioStream {
+public:
+	LatencyProbeStream(Audio::AudioStream *stream, SoundManager *sound, uint32 triggerTime)
+		: _stream(stream), _sound(sound), _triggerTime(triggerTime) {}
+	~LatencyProbeStream() override { delete _stream; }
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		if (!_reported) {
+			_reported = true;
+			_sound->recordLatency(g_system->getMillis() - _triggerTime);
 		}
+		return _stream->readBuffer(buffer, numSamples);
+	}
+	bool isStereo() const override { return _stream->isStereo(); }
+	int getRate() const override { return _stream->getRate(); }
+	bool endOfData() const override { return _stream->endOfData(); }
+	bool endOfStream() const override { return _stream->endOfStream(); }
+
+private:
+	Audio::AudioStream *_stream;
+	SoundManager *_sound;
+	uint32 _triggerTime;
+	bool _reported = false;
+};
 
-		uint32 pcmSize = sound.size - headerSize;
-		byte *pcmData = (byte *)malloc(pcmSize);
-		memcpy(pcmData, data + headerSize, pcmSize);
-		free(data);
-
-		// Create raw audio stream (8-bit unsigned mono is common for old games)
-		stream = Audio::makeRawStream(pcmData, pcmSize, sampleRate, Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
+int SoundManager::playSound(const SonidoFile &sound, byte soundIndex, int channel, int loopCount, SoundCategory category) {
+	uint32 triggerTime = g_system->getMillis();
+	Audio::SeekableAudioStream *stream = nullptr;
+	if (sound.streamable) {
+		// Nothing is read up front, the mixer pulls the PCM from SONIDOS.DAT as it plays
+		Common::SeekableReadStream *pcm = new SampleReadStream(&_sonidosFile, &_sonidosMutex, sound.offset + sound.pcmOffset, sound.pcmSize, this);
+		stream = Audio::makeRawStream(pcm, sound.sampleRate, sound.rawFlags, DisposeAfterUse::YES);
+	} else if (sound.format == SOUND_FORMAT_RIFF) {
+		stream = loadSampleIntoMemory(sound);
+		recordRead(sound.filename.c_str(), g_system->getMillis() - triggerTime);
 	} else {
 		debug("Unknown sound format on sound with name %s at offset %d, with size %d", sound.filename.c_str(), sound.offset, sound.size);
-		free(data);
 		return -1;
 	}
 
 	if (stream) {
 		if (channel == -1) {
-			// Find a free channel
-			channel = findFreeChannel();
+			channel = allocateChannel(category);
+			if (channel < 0) {
+				debug("No channel left for sound %s", sound.filename.c_str());
+				_stats.drops++;
+				delete stream;
+				return -1;
+			}
 		} else {
 			if (_mixer->isSoundHandleActive(_sfxHandles[channel])) {
 				_mixer->stopHandle(_sfxHandles[channel]);
@@ -224,20 +349,29 @@ int SoundManager::playSound(SonidoFile sound, int channel, int loopCount) {
 			}
 		}
 		Audio::AudioStream *finalStream = loopCount != -1 ? stream : Audio::makeLoopingAudioStream(stream, 0);
+		finalStream = new LatencyProbeStream(finalStream, this, triggerTime);
 
 		_mixer->playStream(Audio::Mixer::kSFXSoundType, &_sfxHandles[channel], finalStream, -1, _currentVolume, 0, DisposeAfterUse::YES);
+		assignChannel(channel, soundIndex, category);
+		recordStart(sound.streamable, false);
 		return channel;
 	}
 	return -1;
 }
 
-void SoundManager::playSound(byte *soundData, uint32 size, int channel) {
+void SoundManager::playSound(byte *soundData, uint32 size, int channel, SoundCategory category, bool readAhead) {
+	uint32 triggerTime = g_system->getMillis();
+	// The stream takes ownership of the caller's buffer
+	g_engine->_memStats.handOff(kMemSound, size);
 	Audio::AudioStream *stream = Audio::makeRawStream(soundData, size, 11025, Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
 	if (stream) {
 		if (_mixer->isSoundHandleActive(_sfxHandles[channel])) {
 			_mixer->stopHandle(_sfxHandles[channel]);
 		}
+		stream = new LatencyProbeStream(stream, this, triggerTime);
 		_mixer->playStream(Audio::Mixer::kSFXSoundType, &_sfxHandles[channel], stream, -1, _currentVolume, 0, DisposeAfterUse::YES);
+		assignChannel(channel, 0xFF, category);
+		recordStart(false, readAhead);
 	}
 }
 
@@ -277,19 +411,125 @@ int SoundManager::getSampleRate(byte *data, SoundFormat format) {
 	return sampleRate;
 }
 
-int SoundManager::findFreeChannel() {
-	// Reserve first 3 channels for one-off sounds
-	for (int i = 3; i < kMaxChannels; i++) {
-		if (!_mixer->isSoundHandleActive(_sfxHandles[i])) {
+int SoundManager::allocateChannel(SoundCategory category) {
+	int victim = -1;
+	for (int i = kFirstPooledChannel; i < kMaxChannels; i++) {
+		if (!_mixer->isSoundHandleActive(_sfxHandles[i]))
 			return i;
-		}
+		const ChannelState &state = _channels[i];
+		if (state.category > category)
+			continue;
+		if (victim == -1 || state.category < _channels[victim].category ||
+			(state.category == _channels[victim].category && state.startSerial < _channels[victim].startSerial))
+			victim = i;
+	}
+	if (victim >= 0) {
+		_mixer->stopHandle(_sfxHandles[victim]);
+		_stats.steals++;
+		_tickSteals++;
 	}
-	return 0;
+	return victim;
 }
 
-bool SoundManager::isSoundIndexPlaying(byte index) const {
+void SoundManager::assignChannel(int channel, byte soundIndex, SoundCategory category) {
+	ChannelState &state = _channels[channel];
+	if (state.soundIndex != 0xFF)
+		_indexChannels[state.soundIndex] &= ~(1 << channel);
+	state.soundIndex = soundIndex;
+	state.category = category;
+	state.startSerial = ++_startSerial;
+	if (soundIndex != 0xFF)
+		_indexChannels[soundIndex] |= 1 << channel;
+}
+
+void SoundManager::recordStart(bool streamed, bool cacheHit) {
+	_stats.starts++;
+	_tickStarts++;
+	if (streamed)
+		_stats.streamed++;
+	else if (cacheHit)
+		_stats.cacheHits++;
+	else
+		_stats.cacheMisses++;
+}
+
+void SoundManager::recordRead(const char *name, uint32 ms) {
+	_stats.readMs += ms;
+	if (ms >= _stats.maxReadMs) {
+		_stats.maxReadMs = ms;
+		_stats.slowestRead = name;
+	}
+}
+
+void SoundManager::recordCueDelay(uint32 ms) {
+	_stats.cueDelays++;
+	_stats.cueDelayMs += ms;
+	_stats.maxCueDelayMs = MAX(_stats.maxCueDelayMs, ms);
+}
+
+void SoundManager::recordLatency(uint32 ms) {
+	Common::StackLock lock(_statsMutex);
+	_stats.latencies++;
+	_stats.latencyMs += ms;
+	_stats.maxLatencyMs = MAX(_stats.maxLatencyMs, ms);
+}
+
+void SoundManager::recordStreamRead(uint32 bytes, uint32 ms) {
+	Common::StackLock lock(_statsMutex);
+	_stats.streamReads++;
+	_stats.streamReadBytes += bytes;
+	_stats.streamReadMs += ms;
+	_stats.maxStreamReadMs = MAX(_stats.maxStreamReadMs, ms);
+}
+
+uint SoundManager::sampleTick(uint32 &starts, uint32 &steals) {
+	uint active = 0;
 	for (int i = 0; i < kMaxChannels; i++) {
-		if (_sfxSoundIndex[i] == index && _mixer->isSoundHandleActive(_sfxHandles[i]))
+		if (_mixer->isSoundHandleActive(_sfxHandles[i]))
+			active++;
+	}
+	_stats.ticks++;
+	_stats.activeChannels += active;
+	_stats.maxActiveChannels = MAX<uint32>(_stats.maxActiveChannels, active);
+	starts = _tickStarts;
+	steals = _tickSteals;
+	_tickStarts = 0;
+	_tickSteals = 0;
+	return active;
+}
+
+AudioStats SoundManager::getStats() {
+	Common::StackLock lock(_statsMutex);
+	return _stats;
+}
+
+void SoundManager::resetStats() {
+	Common::StackLock lock(_statsMutex);
+	_stats = AudioStats();
+}
+
+Common::String AudioStats::format() const {
+	Common::String out;
+	out += Common::String::format("Starts: %u (%u streamed, %u read ahead, %u read on trigger), %u dropped\n",
+								  starts, streamed, cacheHits, cacheMisses, drops);
+	out += Common::String::format("Reads: %u ms total, max %u ms%s%s\n", readMs, maxReadMs,
+								  slowestRead.empty() ? "" : " for ", slowestRead.c_str());
+	out += Common::String::format("Streamed reads (mixer thread): %u reads, %u bytes, %u ms total, max %u ms\n",
+								  streamReads, streamReadBytes, streamReadMs, maxStreamReadMs);
+	out += Common::String::format("Channels: avg %.2f, max %u busy over %u ticks, %u stolen\n",
+								  ticks ? (float)activeChannels / ticks : 0.0f, maxActiveChannels, ticks, steals);
+	out += Common::String::format("Trigger to mix: avg %.1f ms, max %u ms over %u sounds\n",
+								  latencies ? (float)latencyMs / latencies : 0.0f, maxLatencyMs, latencies);
+	out += Common::String::format("Cues held for their channel: %u, avg %.1f ms, max %u ms\n",
+								  cueDelays, cueDelays ? (float)cueDelayMs / cueDelays : 0.0f, maxCueDelayMs);
+	return out;
+}
+
+bool SoundManager::isSoundIndexPlaying(byte index) const {
+	// Only the channels the sound was started on; they may have finished since
+	uint16 channels = _indexChannels[index];
+	for (int i = 0; channels != 0; i++, channels >>= 1) {
+		if ((channels & 1) && _mixer->isSoundHandleActive(_sfxHandles[i]))
 			return true;
 	}
 	return false;
@@ -355,10 +595,16 @@ bool SoundManager::isPlaying(int channel) const {
 
 void SoundManager::stopMusic() {
 	_isPaused = false;
+	_localMusic.stop();
 	g_system->getAudioCDManager()->stop();
 }
 
 void SoundManager::pauseMusic() {
+	if (_localMusic.isLoaded()) {
+		_localMusic.pause();
+		_isPaused = true;
+		return;
+	}
 	uint32 elapsed = g_system->getMillis() - _cdPlayStartTime;
 	uint32 elapsedFrames = elapsed * 75 / 1000;
 	_cdTrackStart += elapsedFrames; // advance the start offset
@@ -369,7 +615,7 @@ void SoundManager::pauseMusic() {
 }
 
 bool SoundManager::isMusicPlaying() {
-	return g_system->getAudioCDManager()->isPlaying();
+	return _localMusic.isPlaying() || g_system->getAudioCDManager()->isPlaying();
 }
 
 void SoundManager::playMusicTrack(int trackNumber, bool loop) {
@@ -377,43 +623,61 @@ void SoundManager::playMusicTrack(int trackNumber, bool loop) {
 		// Already playing this track
 		return;
 	}
+	if (_isPaused && _currentMusicTrack == trackNumber && _localMusic.isLoaded()) {
+		// Carries on from where the decoder stopped
+		_localMusic.resume();
+		_isPaused = false;
+		return;
+	}
 	_currentMusicTrack = trackNumber;
 
+	g_system->getAudioCDManager()->stop();
+	if (_localMusic.play(trackNumber, loop)) {
+		_isPaused = false;
+		return;
+	}
+
+	// No ripped track, fall back to the CD
 	if (!_isPaused) {
 		_cdTrackStart = 0;
 		_cdTrackDuration = 0;
-		_cdPlayStartTime = g_system->getMillis();
 	}
-	g_system->getAudioCDManager()->stop();
+	_cdPlayStartTime = g_system->getMillis();
 	g_system->getAudioCDManager()->play(trackNumber, loop ? -1 : 1, _cdTrackStart, _cdTrackDuration);
+	_isPaused = false;
 }
 
 void SoundManager::loadSoundIndex() {
 
-	Common::File sonidosFile;
-	if (!sonidosFile.open(Common::Path("SONIDOS.DAT"))) {
+	if (!_sonidosFile.open(Common::Path("SONIDOS.DAT"))) {
 		debug("Failed to open SONIDOS.DAT");
 		return;
 	}
 	// Read header
 	char magic[4];
-	sonidosFile.read(magic, 4);
+	_sonidosFile.read(magic, 4);
 	if (strncmp(magic, "PACK", 4) != 0) {
 		debug("SONIDOS.DAT has invalid magic");
+		_sonidosFile.close();
 		return;
 	}
-	byte fileCount = sonidosFile.readByte();
-	sonidosFile.skip(3); // Padding bytes
+	byte fileCount = _sonidosFile.readByte();
+	_sonidosFile.skip(3); // Padding bytes
 
+	Common::Array<SonidoFile> sonidos;
 	for (uint32 i = 0; i < fileCount; i++) {
 		SonidoFile sonido;
-		sonido.filename = sonidosFile.readString('\0', 12);
-		sonidosFile.skip(1);
-		sonido.offset = sonidosFile.readUint32LE();
-		sonido.size = sonidosFile.readUint32LE();
-		_soundMap[sonido.filename] = sonido;
+		sonido.filename = _sonidosFile.readString('\0', 12);
+		_sonidosFile.skip(1);
+		sonido.offset = _sonidosFile.readUint32LE();
+		sonido.size = _sonidosFile.readUint32LE();
+		sonidos.push_back(sonido);
+	}
+	// Nothing plays yet, so the handle is still ours alone
+	for (uint32 i = 0; i < sonidos.size(); i++) {
+		parseSampleHeader(sonidos[i]);
+		_soundMap[sonidos[i].filename] = sonidos[i];
 	}
-	sonidosFile.close();
 }
 
 static const uint kAmbientCounterMask = 0x1F; // Trigger when (counter & mask) == mask
@@ -425,12 +689,12 @@ int SoundManager::tickAmbientSound(uint32 frameCount) {
 	}
 
 	// 50% probability gate
-	if (g_engine->getRandomNumber(1) == 0) {
+	if (_ambientRandom.getRandomNumber(1) == 0) {
 		return -1;
 	}
 
 	// Pick random ambient slot 0-3 (corresponds to room sound indices 4-7)
-	int ambientSlotOffset = g_engine->getRandomNumber(3);
+	int ambientSlotOffset = _ambientRandom.getRandomNumber(3);
 
 	return ambientSlotOffset;
 }
@@ -22,19 +22,17 @@
 #ifndef PELROCK_SOUND_H
 #define PELROCK_SOUND_H
 
+#include "audio/audiostream.h"
 #include "audio/mixer.h"
 #include "common/file.h"
+#include "common/mutex.h"
+#include "common/random.h"
 #include "common/scummsys.h"
 #include "common/str.h"
 
-namespace Pelrock {
+#include "pelrock/music.h"
 
-struct SonidoFile {
-	Common::String filename;
-	uint32 offset;
-	uint32 size;
-	byte *data;
-};
+namespace Pelrock {
 
 extern const char *SOUND_FILENAMES[];
 
@@ -46,6 +44,20 @@ enum SoundFormat {
 	SOUND_FORMAT_INVALID
 };
 
+struct SonidoFile {
+	Common::String filename;
+	uint32 offset;
+	uint32 size;
+	byte *data;
+	// Filled in from the sample's header when the index is loaded
+	SoundFormat format = SOUND_FORMAT_INVALID;
+	int sampleRate = 11025;
+	byte rawFlags = 0;
+	bool streamable = false; // the PCM can be played straight from the file
+	uint32 pcmOffset = 0;    // relative to offset
+	uint32 pcmSize = 0;
+};
+
 struct SoundData {
 	SoundFormat format;
 	int sampleRate;
@@ -54,15 +66,58 @@ struct SoundData {
 };
 
 const int kMaxChannels = 15;
+const int kFirstPooledChannel = 3;   // lower channels are only used when asked for by number
 const int kAmbientSoundSlotBase = 4; // Room sound indices 4-7 are ambient sounds
 
+/**
+ * Decides who gives way when every pooled channel is busy: a sound can only take the channel of one
+ * of the same or a lower category.
+ */
+enum SoundCategory {
+	kSoundAmbient,  // random room ambience
+	kSoundScripted, // effects fired by actions, sequences, sprites and menus
+	kSoundVoice     // speech
+};
+
+/**
+ * What starting sounds has cost since the last reset. Times are in milliseconds; latency runs from
+ * the playSound() call to the mixer first pulling samples from the stream.
+ */
+struct AudioStats {
+	uint32 starts = 0;
+	uint32 cacheHits = 0;   // started from a sample read ahead of its trigger
+	uint32 cacheMisses = 0; // read in full when triggered
+	uint32 streamed = 0;    // read piecemeal by the mixer as they play
+	uint32 readMs = 0;      // reading and decoding on the game thread
+	uint32 maxReadMs = 0;
+	Common::String slowestRead;
+	uint32 streamReads = 0; // reads of streamed samples, on the mixer thread
+	uint32 streamReadBytes = 0;
+	uint32 streamReadMs = 0;
+	uint32 maxStreamReadMs = 0;
+	uint32 steals = 0; // pooled channels taken from a playing sound
+	uint32 drops = 0;  // sounds not played for lack of a channel
+	uint32 ticks = 0;
+	uint32 activeChannels = 0; // summed over ticks
+	uint32 maxActiveChannels = 0;
+	uint32 latencies = 0;
+	uint32 latencyMs = 0;
+	uint32 maxLatencyMs = 0;
+	uint32 cueDelays = 0; // scheduled cues that had to wait for their channel
+	uint32 cueDelayMs = 0;
+	uint32 maxCueDelayMs = 0;
+
+	Common::String format() const;
+};
+
 class SoundManager {
 public:
 	SoundManager(Audio::Mixer *mixer);
 	~SoundManager();
-	void playSound(byte index, int channel = -1, int loopCount = 1);
+	void playSound(byte index, int channel = -1, int loopCount = 1, SoundCategory category = kSoundScripted);
 	void playSound(const char *filename, int channel, int loopCount = 1);
-	void playSound(byte *soundData, uint32 size, int channel);
+	/** readAhead tells whether the caller read the data before the sound was due, for the stats. */
+	void playSound(byte *soundData, uint32 size, int channel, SoundCategory category = kSoundScripted, bool readAhead = true);
 	void stopAllSounds();
 	void stopSound(int channel);
 
@@ -87,26 +142,74 @@ public:
 	 * Check if ambient sound should play this frame.
 	 */
 	int tickAmbientSound(uint32 frameCount);
+	/** Ambient rolls have their own stream so input replays can reproduce them. */
+	uint32 getAmbientSeed() const { return _ambientRandom.getSeed(); }
+	void setAmbientSeed(uint32 seed) { _ambientRandom.setSeed(seed); }
 
 	bool isPaused() const { return _isPaused; }
 	byte getCurrentMusicTrack() const { return _currentMusicTrack; }
+	/** Whether the current track comes from a ripped file rather than the CD. */
+	bool isMusicFromFile() { return _localMusic.isLoaded(); }
+	uint32 getMusicUnderruns() { return _localMusic.getUnderruns(); }
+
+	AudioStats getStats();
+	void resetStats();
+	/**
+	 * Samples the busy channels, once per stepped tick. Returns their count, along with the starts
+	 * and steals since the previous call.
+	 */
+	uint sampleTick(uint32 &starts, uint32 &steals);
+	/** Reading a sample outside playSound(), e.g. ahead of a scheduled cue. */
+	void recordRead(const char *name, uint32 ms);
+	/** A due cue reached the mixer this long after its frame. */
+	void recordCueDelay(uint32 ms);
+	/** Called from the mixer thread on a stream's first read. */
+	void recordLatency(uint32 ms);
+	/** Called from the mixer thread for every read of a streamed sample. */
+	void recordStreamRead(uint32 bytes, uint32 ms);
 
 private:
-	int playSound(SonidoFile sound, int channel = -1, int loopCount = 1);
+	int playSound(const SonidoFile &sound, byte soundIndex, int channel, int loopCount, SoundCategory category);
+	/** Reads the sample's header to find its format and where its PCM data lies. */
+	void parseSampleHeader(SonidoFile &sound);
+	Audio::SeekableAudioStream *loadSampleIntoMemory(const SonidoFile &sound);
 	SoundFormat detectFormat(byte *data, uint32 size);
 	int getSampleRate(byte *data, SoundFormat format);
-	int findFreeChannel();
+	/**
+	 * A free pooled channel or, failing that, the least recently started one of the lowest category
+	 * not above the given one, which is stopped. -1 if every channel holds something more important.
+	 */
+	int allocateChannel(SoundCategory category);
+	/** Records what was just started on the channel. */
+	void assignChannel(int channel, byte soundIndex, SoundCategory category);
+	void recordStart(bool streamed, bool cacheHit);
 
 private:
 	Audio::Mixer *_mixer;
 	int _currentVolume;
 	Audio::SoundHandle _musicHandle;
+	struct ChannelState {
+		byte soundIndex = 0xFF; // SOUND_FILENAMES entry, 0xFF if none
+		SoundCategory category = kSoundScripted;
+		uint32 startSerial = 0;
+	};
+
 	Audio::SoundHandle _sfxHandles[kMaxChannels];
-	byte _sfxSoundIndex[kMaxChannels]; // tracks which sound index is on each channel (0xFF = none)
+	ChannelState _channels[kMaxChannels];
+	uint16 _indexChannels[256]; // per sound index, the channels it was last started on
+	uint32 _startSerial = 0;
 	Common::HashMap<Common::String, SonidoFile> _soundMap;
+	Common::File _sonidosFile; // kept open, samples stream straight out of it
+	Common::Mutex _sonidosMutex;
 	bool _isPaused = false;
 	byte _currentMusicTrack = 0;
+	Common::RandomSource _ambientRandom;
+	AudioStats _stats;
+	Common::Mutex _statsMutex; // latencies and stream reads arrive from the mixer thread
+	uint32 _tickStarts = 0;
+	uint32 _tickSteals = 0;
 
+	LocalMusicPlayer _localMusic;
 
 	uint32 _cdTrackStart = 0;
 	uint32 _cdTrackDuration;
@@ -59,7 +59,7 @@ Spell *SpellBook::run() {
 		}
 		g_engine->_screen->markAllDirty();
 		g_engine->_screen->update();
-		g_system->delayMillis(10);
+		g_engine->_chrono->idle();
 	}
 	g_engine->_screen->clear(0);
 	// Restore room palette
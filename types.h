@@ -24,8 +24,10 @@
 #include "common/debug.h"
 #include "common/rect.h"
 #include "common/scummsys.h"
+#include "common/str-array.h"
 #include "common/system.h"
 #include "common/types.h"
+#include "graphics/surface.h"
 
 namespace Pelrock {
 
@@ -137,7 +139,7 @@ enum AlfredDirection {
 };
 
 struct AlfredSpecialAnim {
-	byte *animData = nullptr;
+	byte *animData = nullptr; // view into ResourceManager's decode pool
 	int w = 0;
 	int h = 0;
 	int numFrames = 0;
@@ -147,17 +149,16 @@ struct AlfredSpecialAnim {
 	int curLoop = 0;
 	uint32 size = 0;
 	int speed = 2;
+	bool reversed = false; // frames are played back to front
 	AlfredSpecialAnim(int nF, int width, int height, int nBudas, uint32 off, int lCount, uint32 sz, int spd = 2)
 		: numFrames(nF), w(width), h(height), loopCount(lCount), size(sz), speed(spd) {
 		stride = w * h;
 	}
 
-	~AlfredSpecialAnim() {
-		if (animData) {
-			delete[] animData;
-			animData = nullptr;
-		}
-	}
+	/** Index in animData of the given playback frame. */
+	int frameIndex(int frame) const { return reversed ? numFrames - 1 - frame : frame; }
+	/** The given playback frame, in place in animData. */
+	byte *frameView(int frame) const { return animData + frameIndex(frame) * stride; }
 };
 
 struct ActionPopupState {
@@ -169,6 +170,45 @@ struct ActionPopupState {
 	bool isAlfredUnder = false;
 };
 
+/**
+ * The puff of smoke a sprite or Alfred appears or vanishes behind, drawn over the presented frame.
+ */
+struct SmokeEffectState {
+	bool isActive = false;
+	byte *frames = nullptr;
+	int x = 0;
+	int y = 0;
+	int curFrame = 0;
+	int spriteIndex = -1; // -1 for Alfred
+	bool hide = true;
+	bool swapped = false;
+};
+
+/**
+ * Inputs of the last hover evaluation; the hover result only changes when one of them does.
+ */
+struct HoverCache {
+	bool isValid = false;
+	int mouseX = 0;
+	int mouseY = 0;
+	uint32 roomEpoch = 0;
+	uint32 frameEpoch = 0;
+	// Alfred's hit test reads his position and the scaled frame his mask was built from
+	int alfredX = 0;
+	int alfredY = 0;
+	const byte *alfredFrame = nullptr;
+	int alfredScale = -1;
+	// What the hover chose, put back on a hit since other screens reset the cursor; -1 for none
+	int cursor = -1;
+	uint32 hits = 0;
+	uint32 misses = 0;
+
+	bool matches(int x, int y, uint32 room, uint32 frame, int ax, int ay, const byte *aFrame, int aScale) const {
+		return isValid && mouseX == x && mouseY == y && roomEpoch == room && frameEpoch == frame &&
+			   alfredX == ax && alfredY == ay && alfredFrame == aFrame && alfredScale == aScale;
+	}
+};
+
 struct InventoryOverlayState {
 	bool isActive = false;
 	int invStartingPos = 0;
@@ -262,6 +302,47 @@ struct AlfredSpecialAnimOffset {
 	uint32 size; // 0 = compute from numFrames * w * h
 };
 
+/**
+ * One bit per pixel opacity mask of a frame, so hit tests don't need to touch the pixel data.
+ */
+struct HitMask {
+	int w = 0;
+	int h = 0;
+	int pitch = 0;
+	byte *bits = nullptr;
+	int capacity = 0; // bytes allocated for bits, kept when a rebuild fits
+
+	void build(const byte *pixels, int width, int height, byte transparentColor = 255) {
+		w = width;
+		h = height;
+		pitch = (width + 7) / 8;
+		if (pitch * height > capacity) {
+			delete[] bits;
+			capacity = pitch * height;
+			bits = new byte[capacity];
+		}
+		memset(bits, 0, pitch * height);
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				if (pixels[y * width + x] != transparentColor)
+					bits[y * pitch + (x >> 3)] |= 0x80 >> (x & 7);
+			}
+		}
+	}
+
+	void release() {
+		delete[] bits;
+		bits = nullptr;
+		w = h = pitch = capacity = 0;
+	}
+
+	bool test(int x, int y) const {
+		if (bits == nullptr || x < 0 || y < 0 || x >= w || y >= h)
+			return false;
+		return (bits[y * pitch + (x >> 3)] & (0x80 >> (x & 7))) != 0;
+	}
+};
+
 /**
  * Each Anim has its own speed, loopCount and movement!
  */
@@ -270,6 +351,8 @@ struct Anim {
 	int curFrame = 0;
 	int curLoop = 0;
 	byte **animData;
+	HitMask *hitMasks = nullptr; // one per frame, built at load time
+	int numHitMasks = 0;
 	byte loopCount;
 	byte speed;
 	byte elpapsedFrames = 0;
@@ -429,7 +512,7 @@ struct WalkBoxChange {
 struct InventoryObject {
 	byte index;
 	Common::String description;
-	byte iconData[60 * 60];
+	byte *iconData = nullptr; // view into the icon sheet owned by ResourceManager
 };
 
 struct PaletteAnimFade {
@@ -449,6 +532,9 @@ struct PaletteAnimFade {
 	byte curFrameCount = 0;
 };
 
+static const int kNumStickers = 137;
+static const int kNumRooms = 56;
+
 struct Sticker {
 	int stickerIndex;
 	uint16 x;
@@ -759,6 +845,64 @@ static const FightRoomCfg kFightRooms[] = {
 	{54, 1, 38, 11, 2}, // room 54
 };
 
+enum SequenceId {
+	kSequenceDogPee,
+	kSequenceSorcererAppears,
+	kSequenceSorcererSpell,
+	kSequenceBrickWindow,
+	kSequenceSwimmingPool,
+	kSequenceTravelToEgypt,
+	kSequencePyramidCollapse,
+	kSequenceEnding,
+	kSequenceCredits,
+};
+
+enum SequenceWait {
+	kSequenceWaitNone,
+	kSequenceWaitTicks,
+	kSequenceWaitSpecialAnim, // Alfred's special animation
+	kSequenceWaitDialogue,    // a line started with sayInScene()
+	kSequenceWaitWalk,
+	kSequenceWaitSmoke,
+	kSequenceWaitAction, // a queued action, and any dialogue or conversation it runs
+};
+
+/**
+ * A scripted sequence driven by the main loop. Each game tick the runner resumes it at
+ * `step` once its wait is over; the step function sets the next step and what to wait for.
+ */
+struct Sequence {
+	SequenceId id;
+	int step = 0;
+	bool blocksInput = true;
+	bool keepOnRoomChange = false; // cutscenes that move to another room from one of their steps
+	SequenceWait wait = kSequenceWaitNone;
+	int ticksLeft = 0;
+	int counter = 0; // for the steps' own use: frames shown, fade steps done...
+
+	void waitTicks(int ticks) {
+		wait = kSequenceWaitTicks;
+		ticksLeft = ticks;
+	}
+	void waitFor(SequenceWait what) { wait = what; }
+};
+
+/**
+ * What the cutscene sequences keep between their steps: an extra screen shown in place of the
+ * room with its own sprites, and text drawn over the frame.
+ */
+struct CutsceneState {
+	bool extraScreen = false;        // _bgScreen is shown instead of the room
+	byte *palette = nullptr;         // the extra screen's own, which some cutscenes animate
+	Common::Array<Sprite *> sprites; // animated over the extra screen, owned
+	bool showTitle = false;          // the game's title over the ending screen
+	Graphics::Surface creditsPage;   // text of the credits page on screen, 255 is transparent
+	int creditsPageY = 0;
+	int creditsPageIndex = 0;
+	Common::Array<Common::StringArray> creditTexts;
+	Common::Array<byte> creditSpeakers;
+};
+
 } // End of namespace Pelrock
 
 #endif
@@ -179,6 +179,27 @@ size_t rleDecompress(
 	return result_size;
 }
 
+size_t rleDecompressInto(const byte *input, size_t inputSize, uint32 offset, byte *out, uint32 size) {
+	// Same uncompressed markers as rleDecompress()
+	if (inputSize == 0x8000 || inputSize == 0x6800) {
+		size_t copySize = MIN<size_t>(inputSize, size);
+		memcpy(out, input + offset, copySize);
+		return copySize;
+	}
+
+	size_t resultSize = 0;
+	uint32 pos = offset;
+	while (pos + 2 <= inputSize && resultSize < size) {
+		byte count = input[pos];
+		byte value = input[pos + 1];
+		for (int i = 0; i < count && resultSize < size; i++) {
+			out[resultSize++] = value;
+		}
+		pos += 2;
+	}
+	return resultSize;
+}
+
 void readUntilBuda(Common::SeekableReadStream *stream, uint32 startPos, byte *&buffer, size_t &outSize) {
 	const int markerLen = 4;
 	size_t bufferSize = 4096;
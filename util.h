@@ -32,10 +32,20 @@
 namespace Pelrock {
 
 size_t rleDecompress(const byte *data, size_t data_size, uint32 offset, uint32 size, byte **out_data, bool untilBuda = true);
+/**
+ * Fixed size rleDecompress() that fills the caller's buffer instead of allocating one.
+ */
+size_t rleDecompressInto(const byte *data, size_t data_size, uint32 offset, byte *out, uint32 size);
 void readUntilBuda(Common::SeekableReadStream *stream, uint32 startPos, byte *&buffer, size_t &outSize);
 void rleDecompressSingleBuda(Common::SeekableReadStream *stream, uint32 startPos, byte *&buffer, size_t &outSize);
 void drawSpriteToBuffer(Graphics::ManagedSurface &dest, byte *sprite, int x, int y, int width, int height, int transparentColor);
 void extractSingleFrame(byte *source, byte *dest, int frameIndex, int frameWidth, int frameHeight);
+/**
+ * Frames in a sheet are stored back to back, so a frame can be used in place instead of extracted.
+ */
+inline byte *frameAt(byte *sheet, int frameIndex, int frameWidth, int frameHeight) {
+	return sheet + frameIndex * frameWidth * frameHeight;
+}
 
 void drawText(Graphics::ManagedSurface &dest, Graphics::Font *font, Common::String text, int x, int y, int w, byte color, Graphics::TextAlign align = Graphics::kTextAlignLeft);
 void drawText(Graphics::Font *font, Common::String text, int x, int y, int w, byte color);
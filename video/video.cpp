@@ -37,7 +37,7 @@ VideoManager::VideoManager(
 	ChronoManager *chrono,
 	LargeFont *largeFont,
 	DialogManager *dialog,
-	SoundManager *sound) : _screen(screen), _events(events), _chrono(chrono), _largeFont(largeFont), _dialog(dialog), _sound(sound) {
+	SoundManager *sound) : _screen(screen), _events(events), _chrono(chrono), _largeFont(largeFont), _dialog(dialog), _sound(sound), _audioCues(sound) {
 	_videoSurface.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
 	_textSurface.create(640, 400, Graphics::PixelFormat::createFormatCLUT8());
 	if (!_introSndFile.open("introsnd.dat")) {
@@ -50,8 +50,26 @@ VideoManager::~VideoManager() {
 	_introSndFile.close();
 }
 
+void VideoManager::scheduleAudio() {
+	_audioCues.clear();
+	for (auto &it : _voiceEffect) {
+		// Voices never cut each other off: a line waits for the previous one to end
+		const VoiceData &voice = _sounds[it._value.filename];
+		_audioCues.addSampleCue(it._key, 0, kSoundVoice, true, &_introSndFile, voice.offset, voice.length);
+	}
+	for (auto &it : _sfxEffect) {
+		const VoiceData &sfx = _sounds[it._value.filename];
+		_audioCues.addSampleCue(it._key, 1, kSoundScripted, false, &_introSndFile, sfx.offset, sfx.length);
+	}
+	for (auto &it : _musicEffect) {
+		_audioCues.addMusicCue(it._key, it._value.trackNumber, true);
+	}
+	_audioCues.start();
+}
+
 void VideoManager::playIntro() {
 	initMetadata();
+	scheduleAudio();
 	Common::File videoFile;
 	if (!videoFile.open("ESCENAX.SSN")) {
 		error("Could not open ESCENAX.SSN");
@@ -72,6 +90,7 @@ void VideoManager::playIntro() {
 		readChunk(videoFile, chunk);
 
 		if (_events->_lastKeyEvent == Common::KEYCODE_ESCAPE) {
+			freeChunk(chunk);
 			break;
 		}
 
@@ -85,41 +104,13 @@ void VideoManager::playIntro() {
 				_events->pollEvent();
 				if (_chrono->_gameTick && _chrono->getFrameCount() % frameSkip == 0)
 					break;
-				g_system->delayMillis(10);
+				_audioCues.service();
+				_chrono->waitForNextTick();
 			}
 
 			int currentFrame = frameCounter++;
 			processFrame(chunk, currentFrame);
-
-			if (_voiceEffect.contains(currentFrame)) {
-				// Wait for any playing voice to finish before starting new one
-				while (_sound->isPlaying(0)) {
-					_events->pollEvent();
-					g_system->delayMillis(10);
-					if (g_engine->shouldQuit() || _events->_lastKeyEvent == Common::KEYCODE_ESCAPE)
-						break;
-				}
-				AudioEffect voice = _voiceEffect[currentFrame];
-				VoiceData voiceData = _sounds[voice.filename];
-				_introSndFile.seek(voiceData.offset, SEEK_SET);
-				byte *voiceBuffer = new byte[voiceData.length];
-				_introSndFile.read(voiceBuffer, voiceData.length);
-				_sound->playSound(voiceBuffer, voiceData.length, 0);
-			}
-
-			if (_sfxEffect.contains(currentFrame)) {
-				AudioEffect sfx = _sfxEffect[currentFrame];
-				VoiceData sfxData = _sounds[sfx.filename];
-				_introSndFile.seek(sfxData.offset, SEEK_SET);
-				byte *sfxBuffer = new byte[sfxData.length];
-				_introSndFile.read(sfxBuffer, sfxData.length);
-				_sound->playSound(sfxBuffer, sfxData.length, 1);
-			}
-
-			if (_musicEffect.contains(currentFrame)) {
-				MusicEffect music = _musicEffect[currentFrame];
-				_sound->playMusicTrack(music.trackNumber, true);
-			}
+			_audioCues.update(currentFrame);
 
 			// subtitles are suppressed in the frame range 571-669)
 			bool skipSubs = (currentFrame >= 571 && currentFrame <= 669);
@@ -145,14 +136,25 @@ void VideoManager::playIntro() {
 			break;
 		case 6:
 			// type 6 is merely wait for 20ms
-			g_system->delayMillis(20);
+			_chrono->sleep(20);
 			break;
 		default:
 			debug("Unknown chunk type %d encountered", chunk.chunkType);
 			break;
 		}
+		freeChunk(chunk);
 	}
 
+	if (videoExitFlag) {
+		// Played to the end: lines still queued behind the one playing get their turn
+		while (_audioCues.hasWaiting() && !g_engine->shouldQuit() && _events->_lastKeyEvent != Common::KEYCODE_ESCAPE) {
+			_events->pollEvent();
+			_audioCues.service();
+			_chrono->waitForNextTick();
+		}
+	}
+	// Whatever is still queued now belongs to the part of the intro that was skipped
+	_audioCues.clear();
 	videoFile.close();
 }
 
@@ -169,6 +171,7 @@ void VideoManager::loadPalette(ChunkHeader &chunk) {
 byte *VideoManager::decodeCopyBlock(byte *data, uint32 offset) {
 
 	byte *buf = new byte[256000];
+	g_engine->_memStats.add(kMemVideo, 256000);
 	memset(buf, 0, 256000);
 	uint32 pos = offset + 0x04;
 	// frames are encoded so that each block copy has a 5-byte header
@@ -197,6 +200,7 @@ byte *VideoManager::decodeCopyBlock(byte *data, uint32 offset) {
 
 byte *VideoManager::decodeRLE(byte *data, size_t size, uint32 offset) {
 	byte *buf = new byte[256000];
+	g_engine->_memStats.add(kMemVideo, 256000);
 	memset(buf, 0, 256000);
 	uint32 pos = offset;
 	uint32 outPos = 0;
@@ -229,9 +233,16 @@ void VideoManager::readChunk(Common::SeekableReadStream &stream, ChunkHeader &ch
 	chunk.chunkType = stream.readByte();
 
 	chunk.data = new byte[chunk.blockCount * chunkSize + 9];
+	g_engine->_memStats.add(kMemVideo, chunk.blockCount * chunkSize + 9);
 	stream.read(chunk.data, chunk.blockCount * chunkSize - 9);
 }
 
+void VideoManager::freeChunk(ChunkHeader &chunk) {
+	delete[] chunk.data;
+	chunk.data = nullptr;
+	g_engine->_memStats.remove(kMemVideo, chunk.blockCount * chunkSize + 9);
+}
+
 void VideoManager::processFrame(ChunkHeader &chunk, const int frameCount) {
 	byte *frameData = nullptr;
 	if (chunk.chunkType == 1) {
@@ -251,7 +262,10 @@ void VideoManager::processFrame(ChunkHeader &chunk, const int frameCount) {
 			surfacePixels[i] ^= frameData[i];
 		}
 	}
-	delete[] frameData;
+	if (frameData != nullptr) {
+		delete[] frameData;
+		g_engine->_memStats.remove(kMemVideo, 256000);
+	}
 }
 
 void VideoManager::presentFrame() {
@@ -24,6 +24,7 @@
 
 #include "graphics/surface.h"
 
+#include "pelrock/audiocues.h"
 #include "pelrock/events.h"
 #include "pelrock/fonts/large_font.h"
 
@@ -99,6 +100,7 @@ private:
 	byte *decodeCopyBlock(byte *data, uint32 offset);
 	byte *decodeRLE(byte *data, size_t size, uint32 offset);
 	void readChunk(Common::SeekableReadStream &stream, ChunkHeader &chunk);
+	void freeChunk(ChunkHeader &chunk);
 	void processFrame(ChunkHeader &chunk, const int frameCount);
 	void presentFrame();
 	void initMetadata();
@@ -108,6 +110,8 @@ private:
 	AudioEffect readAudioEffect(Common::File &metadataFile);
 	char decodeChar(byte c);
 	Subtitle *getSubtitleForFrame(uint16 frameNumber);
+	/** Puts the voice, sound and music timelines of the intro on the cue scheduler. */
+	void scheduleAudio();
 	uint _currentSubtitleIndex = 0;
 	Graphics::Surface _videoSurface = Graphics::Surface();
 	Graphics::ManagedSurface _textSurface = Graphics::ManagedSurface();
@@ -118,6 +122,7 @@ private:
 	Common::HashMap<uint16, MusicEffect> _musicEffect;
 	Common::HashMap<Common::String, VoiceData> _sounds;
 	Common::File _introSndFile;
+	AudioCueScheduler _audioCues;
 };
 
 } // End of namespace Pelrock